@@ -0,0 +1,613 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "NullRenderingDeviceDriver.h"
+#include "core/command/CommandBuffer.h"
+#include "core/command/CommandBufferType.h"
+#include "core/command/CommandPool.h"
+#include "core/framegraph/FrameGraph.h"
+#include "core/framegraph/FrameGraphArena.h"
+#include "core/framegraph/FrameGraphCache.h"
+#include "core/framegraph/FrameGraphResourcePool.h"
+#include "core/framegraph/ParallelPassRecorder.h"
+#include "core/framegraph/RenderPassContext.h"
+#include "core/image/Image.h"
+
+namespace {
+    std::atomic<uint64_t> allocationCount{0};
+    std::atomic<uint64_t> allocatedBytes{0};
+
+    void* allocate(const std::size_t size, const std::size_t alignment) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+        void* pointer = alignment > alignof(std::max_align_t)
+                            ? std::aligned_alloc(alignment, (std::max<std::size_t>(size, 1) + alignment - 1) /
+                                                            alignment * alignment)
+                            : std::malloc(std::max<std::size_t>(size, 1));
+        if (!pointer)
+            throw std::bad_alloc{};
+
+        return pointer;
+    }
+}
+
+void* operator new(const std::size_t size) {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](const std::size_t size) {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+namespace Vixen::Bench {
+    enum class Shape {
+        /**
+         * Every pass samples the output of the pass before it.
+         */
+        Chain,
+
+        /**
+         * One pass writes a buffer every other pass reads, and a last pass gathers all of their outputs.
+         */
+        FanOut,
+
+        /**
+         * Repeated diamonds, in which two compute passes read the output of a graphics pass and a third combines
+         * them into the input of the next diamond.
+         */
+        Diamond,
+
+        /**
+         * The chain, with its passes recorded into secondary command buffers on the threads of a recorder.
+         */
+        ParallelChain
+    };
+
+    constexpr Shape Shapes[] = {Shape::Chain, Shape::FanOut, Shape::Diamond, Shape::ParallelChain};
+
+    constexpr uint32_t PassCounts[] = {10, 100, 1000, 10000};
+
+    constexpr uint32_t FramesInFlight = 2;
+
+    constexpr uint32_t RecordingThreads = 4;
+
+    std::string_view toString(const Shape shape) {
+        switch (shape) {
+        case Shape::Chain:
+            return "chain";
+        case Shape::FanOut:
+            return "fan-out";
+        case Shape::Diamond:
+            return "diamond";
+        case Shape::ParallelChain:
+            return "parallel-chain";
+        }
+
+        return "unknown";
+    }
+
+    struct Options {
+        uint32_t frames = 0;
+
+        std::optional<Shape> shape;
+
+        std::optional<uint32_t> passes;
+
+        bool csv = false;
+    };
+
+    struct Result {
+        Shape shape;
+
+        uint32_t passes;
+
+        uint32_t frames;
+
+        std::chrono::nanoseconds coldCompile;
+
+        std::chrono::nanoseconds build;
+
+        std::chrono::nanoseconds compile;
+
+        std::chrono::nanoseconds execute;
+
+        uint64_t allocations;
+
+        uint64_t allocatedBytes;
+    };
+
+    struct PassData {
+        ImageHandle image;
+
+        BufferHandle buffer;
+    };
+
+    /**
+     * The state one shape and pass count is measured with, which persists across frames like it would in a renderer.
+     */
+    struct Context {
+        NullRenderingDeviceDriver& driver;
+
+        CommandBuffer* commandBuffer;
+
+        Image& backbuffer;
+
+        FrameGraphArena arena;
+
+        FrameGraphCache cache;
+
+        FrameGraphResourcePool pool;
+
+        ParallelPassRecorder recorder;
+
+        uint32_t frameIndex = 0;
+
+        Context(NullRenderingDeviceDriver& driver, CommandBuffer* commandBuffer, Image& backbuffer)
+            : driver(driver),
+              commandBuffer(commandBuffer),
+              backbuffer(backbuffer),
+              pool(driver, FramesInFlight),
+              recorder(driver, 0, FramesInFlight, RecordingThreads) {}
+    };
+
+    constexpr auto Execute = [](const PassData&, RenderPassContext&) {};
+
+    ImageResourceDescription getImageDescription() {
+        return {
+            .format = {
+                .format = R8G8B8A8_UNORM,
+                .width = 256,
+                .height = 256,
+                .depth = 1,
+                .layerCount = 1,
+                .mipmapCount = 1,
+                .type = ImageType::TwoD,
+                .samples = ImageSamples::One,
+                .usage = ImageUsageBits::ColorAttachment | ImageUsageBits::Sampling | ImageUsageBits::Storage
+            },
+            .view = {
+                .format = R8G8B8A8_UNORM,
+                .swizzleRed = ImageSwizzle::Identity,
+                .swizzleGreen = ImageSwizzle::Identity,
+                .swizzleBlue = ImageSwizzle::Identity,
+                .swizzleAlpha = ImageSwizzle::Identity
+            }
+        };
+    }
+
+    BufferFormat getBufferDescription() {
+        return {
+            .count = 1024,
+            .stride = 16,
+            .usage = BufferUsageBits::Storage
+        };
+    }
+
+    ImageHandle importBackbuffer(FrameGraph::Builder& builder, Image& backbuffer) {
+        return builder.importImage(
+            "backbuffer",
+            backbuffer,
+            {},
+            {
+                .stages = PipelineStageBits::Copy,
+                .access = BarrierAccessBits::CopyRead,
+                .layout = ImageLayout::CopySourceOptimal
+            }
+        );
+    }
+
+    /**
+     * Adds a graphics pass that samples the input, if any, and renders into the target.
+     */
+    ImageHandle addBlit(FrameGraph::Builder& builder, const std::string& name, ImageHandle input, ImageHandle target) {
+        ImageHandle output;
+        builder.addGraphicsPass<PassData>(
+            name,
+            [&](RenderPass::Builder& pass, PassData& data) {
+                if (input.isValid())
+                    data.image = pass.read(input, ImageUsageBits::Sampling, PipelineStageBits::FragmentShader);
+
+                output = pass.addColorAttachment(target, LoadAction::DontCare, StoreAction::Store);
+            },
+            Execute
+        );
+
+        return output;
+    }
+
+    void buildChain(FrameGraph::Builder& builder, Image& backbuffer, const uint32_t passes) {
+        std::string name;
+        ImageHandle previous;
+        for (uint32_t i = 0; i + 1 < passes; ++i) {
+            name = "chain" + std::to_string(i);
+            previous = addBlit(builder, name, previous, builder.createImage(name, getImageDescription()));
+        }
+
+        addBlit(builder, "present", previous, importBackbuffer(builder, backbuffer));
+    }
+
+    void buildFanOut(
+        FrameGraph::Builder& builder,
+        std::pmr::memory_resource& memory,
+        Image& backbuffer,
+        const uint32_t passes
+    ) {
+        auto source = builder.createBuffer("source", getBufferDescription());
+        builder.addComputePass<PassData>(
+            "source",
+            [&](RenderPass::Builder& pass, PassData& data) {
+                source = data.buffer = pass.write(source, BufferUsageBits::Storage, PipelineStageBits::ComputeShader);
+            },
+            Execute
+        );
+
+        std::pmr::vector<BufferHandle> outputs{&memory};
+        std::string name;
+        for (uint32_t i = 0; i + 2 < passes; ++i) {
+            name = "fan" + std::to_string(i);
+            const auto target = builder.createBuffer(name, getBufferDescription());
+            builder.addComputePass<PassData>(
+                name,
+                [&](RenderPass::Builder& pass, PassData& data) {
+                    pass.read(source, BufferUsageBits::Storage, PipelineStageBits::ComputeShader);
+                    data.buffer = pass.write(target, BufferUsageBits::Storage, PipelineStageBits::ComputeShader);
+                    outputs.push_back(data.buffer);
+                },
+                Execute
+            );
+        }
+
+        const auto target = importBackbuffer(builder, backbuffer);
+        builder.addGraphicsPass<PassData>(
+            "gather",
+            [&](RenderPass::Builder& pass, PassData& data) {
+                for (const auto output : outputs)
+                    pass.read(output, BufferUsageBits::Storage, PipelineStageBits::FragmentShader);
+
+                data.image = pass.addColorAttachment(target, LoadAction::Clear, StoreAction::Store);
+            },
+            Execute
+        );
+    }
+
+    void buildDiamond(FrameGraph::Builder& builder, Image& backbuffer, const uint32_t passes) {
+        std::string name;
+        ImageHandle top;
+        for (uint32_t i = 0; i + 4 <= passes; i += 4) {
+            const auto index = std::to_string(i / 4);
+            name = "top" + index;
+            top = addBlit(builder, name, top, builder.createImage(name, getImageDescription()));
+
+            BufferHandle sides[2];
+            for (uint32_t side = 0; side < 2; ++side) {
+                name = (side == 0 ? "left" : "right") + index;
+                const auto target = builder.createBuffer(name, getBufferDescription());
+                builder.addComputePass<PassData>(
+                    name,
+                    [&](RenderPass::Builder& pass, PassData& data) {
+                        pass.read(top, ImageUsageBits::Storage, PipelineStageBits::ComputeShader);
+                        data.buffer = pass.write(target, BufferUsageBits::Storage, PipelineStageBits::ComputeShader);
+                        sides[side] = data.buffer;
+                    },
+                    Execute
+                );
+            }
+
+            name = "bottom" + index;
+            const auto target = builder.createImage(name, getImageDescription());
+            builder.addGraphicsPass<PassData>(
+                name,
+                [&](RenderPass::Builder& pass, PassData& data) {
+                    for (const auto side : sides)
+                        pass.read(side, BufferUsageBits::Storage, PipelineStageBits::FragmentShader);
+
+                    data.image = pass.addColorAttachment(target, LoadAction::DontCare, StoreAction::Store);
+                    top = data.image;
+                },
+                Execute
+            );
+        }
+
+        addBlit(builder, "present", top, importBackbuffer(builder, backbuffer));
+    }
+
+    FrameGraph build(Context& context, const Shape shape, const uint32_t passes) {
+        FrameGraph::Builder builder{&context.arena};
+
+        switch (shape) {
+        case Shape::Chain:
+        case Shape::ParallelChain:
+            buildChain(builder, context.backbuffer, passes);
+            break;
+        case Shape::FanOut:
+            buildFanOut(builder, context.arena, context.backbuffer, passes);
+            break;
+        case Shape::Diamond:
+            buildDiamond(builder, context.backbuffer, passes);
+            break;
+        }
+
+        return std::move(builder).build();
+    }
+
+    std::chrono::nanoseconds getMedian(std::vector<std::chrono::nanoseconds>& times) {
+        std::ranges::nth_element(times, times.begin() + times.size() / 2);
+
+        return times[times.size() / 2];
+    }
+
+    /**
+     * Recycles the per-frame state of the context and begins its command buffer, like a device beginning a frame.
+     */
+    void beginFrame(Context& context) {
+        context.arena.reset();
+        context.pool.beginFrame();
+        context.recorder.beginFrame(context.frameIndex);
+        context.frameIndex = (context.frameIndex + 1) % FramesInFlight;
+        context.driver.beginCommandBuffer(context.commandBuffer).value();
+    }
+
+    void execute(Context& context, FrameGraph& graph, const Shape shape) {
+        if (shape == Shape::ParallelChain)
+            graph.execute(context.pool, context.commandBuffer, context.recorder);
+        else
+            graph.execute(context.pool, context.commandBuffer);
+    }
+
+    void executeFrame(Context& context, const Shape shape, const uint32_t passes) {
+        beginFrame(context);
+        {
+            auto graph = build(context, shape, passes);
+            graph.compile(context.cache);
+            execute(context, graph, shape);
+        }
+        context.driver.endCommandBuffer(context.commandBuffer);
+    }
+
+    /**
+     * Runs frames to warm the arena, cache and pool, and then measures the frames after them. Each frame is built,
+     * compiled and executed like a renderer would, with the execute time including the graph returning its resources
+     * to the pool when it is destroyed.
+     */
+    Result run(NullRenderingDeviceDriver& driver, CommandBuffer* commandBuffer, Image& backbuffer,
+               const Shape shape, const uint32_t passes, const uint32_t frames) {
+        Context context{driver, commandBuffer, backbuffer};
+
+        std::chrono::nanoseconds coldCompile{};
+        {
+            beginFrame(context);
+            auto graph = build(context, shape, passes);
+            const auto start = std::chrono::steady_clock::now();
+            graph.compile(context.cache);
+            coldCompile = std::chrono::steady_clock::now() - start;
+            execute(context, graph, shape);
+            driver.endCommandBuffer(commandBuffer);
+        }
+
+        // The pool hands objects back only once the frames that used them have completed, so the frames after the
+        // first create their own until then.
+        for (uint32_t frame = 1; frame < FramesInFlight; ++frame)
+            executeFrame(context, shape, passes);
+
+        std::vector<std::chrono::nanoseconds> buildTimes;
+        std::vector<std::chrono::nanoseconds> compileTimes;
+        std::vector<std::chrono::nanoseconds> executeTimes;
+        buildTimes.reserve(frames);
+        compileTimes.reserve(frames);
+        executeTimes.reserve(frames);
+
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        for (uint32_t frame = 0; frame < frames; ++frame) {
+            beginFrame(context);
+
+            const auto allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            const auto bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+
+            const auto start = std::chrono::steady_clock::now();
+            std::chrono::steady_clock::time_point built;
+            std::chrono::steady_clock::time_point compiled;
+            {
+                auto graph = build(context, shape, passes);
+                built = std::chrono::steady_clock::now();
+                graph.compile(context.cache);
+                compiled = std::chrono::steady_clock::now();
+                execute(context, graph, shape);
+            }
+            const auto executed = std::chrono::steady_clock::now();
+            driver.endCommandBuffer(commandBuffer);
+
+            allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+            bytes += allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+
+            buildTimes.push_back(built - start);
+            compileTimes.push_back(compiled - built);
+            executeTimes.push_back(executed - compiled);
+        }
+
+        return {
+            .shape = shape,
+            .passes = passes,
+            .frames = frames,
+            .coldCompile = coldCompile,
+            .build = getMedian(buildTimes),
+            .compile = getMedian(compileTimes),
+            .execute = getMedian(executeTimes),
+            // Rounded up, so that a single allocation across all frames still shows.
+            .allocations = (allocations + frames - 1) / frames,
+            .allocatedBytes = bytes / frames
+        };
+    }
+
+    void writeJson(std::ostream& stream, const std::vector<Result>& results) {
+        stream << "{\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            stream << (i == 0 ? "\n" : ",\n")
+                << "    {\"shape\": \"" << toString(result.shape) << "\""
+                << ", \"passes\": " << result.passes
+                << ", \"frames\": " << result.frames
+                << ", \"coldCompileNs\": " << result.coldCompile.count()
+                << ", \"buildNs\": " << result.build.count()
+                << ", \"compileNs\": " << result.compile.count()
+                << ", \"executeNs\": " << result.execute.count()
+                << ", \"allocationsPerFrame\": " << result.allocations
+                << ", \"allocatedBytesPerFrame\": " << result.allocatedBytes << "}";
+        }
+        stream << "\n  ]\n}\n";
+    }
+
+    void writeCsv(std::ostream& stream, const std::vector<Result>& results) {
+        stream << "shape,passes,frames,coldCompileNs,buildNs,compileNs,executeNs,allocationsPerFrame,"
+            "allocatedBytesPerFrame\n";
+        for (const auto& result : results)
+            stream << toString(result.shape) << ','
+                << result.passes << ','
+                << result.frames << ','
+                << result.coldCompile.count() << ','
+                << result.build.count() << ','
+                << result.compile.count() << ','
+                << result.execute.count() << ','
+                << result.allocations << ','
+                << result.allocatedBytes << '\n';
+    }
+
+    std::optional<Options> parseOptions(const int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (argument == "--csv") {
+                options.csv = true;
+            } else if (argument == "--json") {
+                options.csv = false;
+            } else if (argument == "--frames" && hasValue) {
+                options.frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (argument == "--passes" && hasValue) {
+                options.passes = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (argument == "--shape" && hasValue) {
+                const std::string_view name = argv[++i];
+                const auto shape = std::ranges::find(Shapes, name, toString);
+                if (shape == std::end(Shapes))
+                    return std::nullopt;
+
+                options.shape = *shape;
+            } else {
+                return std::nullopt;
+            }
+        }
+
+        return options;
+    }
+}
+
+int main(const int argc, char** argv) {
+    using namespace Vixen;
+    using namespace Vixen::Bench;
+
+    const auto options = parseOptions(argc, argv);
+    if (!options) {
+        std::cerr << "Usage: " << argv[0] << " [--json | --csv] [--frames <count>] [--passes <count>]"
+            " [--shape chain|fan-out|diamond|parallel-chain]\n";
+        return EXIT_FAILURE;
+    }
+
+    NullRenderingDeviceDriver driver;
+    auto* commandPool = driver.createCommandPool(0, CommandBufferType::Primary).value();
+    auto* commandBuffer = driver.createCommandBuffer(commandPool).value();
+    auto* backbuffer = driver.createImage(getImageDescription().format, getImageDescription().view).value();
+
+    std::vector<uint32_t> passCounts;
+    if (options->passes)
+        passCounts.push_back(std::max<uint32_t>(*options->passes, 4));
+    else
+        passCounts.assign(std::begin(PassCounts), std::end(PassCounts));
+
+    std::vector<Result> results;
+    for (const auto shape : Shapes) {
+        if (options->shape && *options->shape != shape)
+            continue;
+
+        for (const auto passes : passCounts) {
+            // Small graphs are run for more frames so every case takes a similar, measurable amount of time.
+            const auto frames = options->frames != 0 ? options->frames : std::clamp(20000 / passes, 5u, 1000u);
+            results.push_back(run(driver, commandBuffer, *backbuffer, shape, passes, frames));
+        }
+    }
+
+    if (options->csv)
+        writeCsv(std::cout, results);
+    else
+        writeJson(std::cout, results);
+
+    // Once warmed up, a frame that builds the same graph again must not allocate from the global heap.
+    bool allocated = false;
+    for (const auto& result : results) {
+        if (result.allocations == 0)
+            continue;
+
+        std::cerr << "Steady-state frames of the " << toString(result.shape) << " graph with " << result.passes
+            << " passes allocated " << result.allocations << " times per frame\n";
+        allocated = true;
+    }
+
+    driver.destroyImage(backbuffer);
+    delete commandBuffer;
+    driver.destroyCommandPool(commandPool);
+
+    return allocated ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <optional>
-#include <vector>
+#include <span>
 
 #include "ClearValue.h"
 #include "LoadAction.h"
@@ -29,7 +29,7 @@ namespace Vixen {
     struct RenderingInfo {
         glm::uvec2 extent;
 
-        std::vector<AttachmentInfo> colorAttachments;
+        std::span<const AttachmentInfo> colorAttachments;
 
         std::optional<AttachmentInfo> depthStencilAttachment;
     };
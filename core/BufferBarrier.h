@@ -13,5 +13,7 @@ namespace Vixen {
         BarrierAccessFlags destinationAccess;
         uint64_t offset;
         uint64_t size;
+        uint32_t sourceQueueFamily;
+        uint32_t destinationQueueFamily;
     };
 }
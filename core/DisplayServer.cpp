@@ -21,6 +21,10 @@
 #include "platform/opengl/OpenGLRenderingContext.h"
 #endif
 
+#ifdef NULL_ENABLED
+#include "platform/null/NullRenderingContextDriver.h"
+#endif
+
 namespace Vixen {
     auto DisplayServer::createWindow(
         const std::string& title,
@@ -98,7 +102,12 @@ namespace Vixen {
             case RenderingDriver::OpenGL:
                 renderingContextDriver = new VulkanRenderingContextDriver(applicationName, applicationVersion);
                 break;
-            }
+                #endif
+
+                #ifdef NULL_ENABLED
+            case RenderingDriver::Null:
+                renderingContextDriver = new NullRenderingContextDriver();
+                break;
                 #endif
 
             default:
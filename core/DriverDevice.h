@@ -18,5 +18,15 @@ namespace Vixen {
         uint64_t deviceLocalMemory = 0;
         bool hasDedicatedComputeQueue = false;
         bool hasDedicatedTransferQueue = false;
+
+        /**
+         * The alignment the offsets uniform buffers are bound at must have.
+         */
+        uint64_t uniformBufferOffsetAlignment = 256;
+
+        /**
+         * The largest range of a uniform buffer that can be bound at once.
+         */
+        uint64_t maxUniformBufferRange = 16384;
     };
 }
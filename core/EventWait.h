@@ -0,0 +1,29 @@
+#pragma once
+
+#include <span>
+
+#include "BufferBarrier.h"
+#include "ImageBarrier.h"
+#include "MemoryBarrier.h"
+#include "PipelineStageFlags.h"
+
+namespace Vixen {
+    struct Event;
+
+    /**
+     * An event to wait on, along with the barriers it was signaled with.
+     */
+    struct EventWait {
+        Event* event;
+
+        PipelineStageFlags sourceStages;
+
+        PipelineStageFlags destinationStages;
+
+        std::span<const MemoryBarrier> memoryBarriers;
+
+        std::span<const BufferBarrier> bufferBarriers;
+
+        std::span<const ImageBarrier> imageBarriers;
+    };
+}
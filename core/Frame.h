@@ -1,21 +1,42 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "Swapchain.h"
 #include "command/CommandBuffer.h"
 #include "command/CommandPool.h"
-#include "command/Fence.h"
 #include "command/Semaphore.h"
 
 namespace Vixen {
+    class Buffer;
+    struct Image;
+    struct Sampler;
+    struct Shader;
+
     struct Frame {
         CommandPool* commandPool;
         CommandBuffer* commandBuffer;
+        CommandBuffer* commandBufferAfterCompute;
+        CommandPool* computeCommandPool;
+        CommandBuffer* computeCommandBuffer;
+        bool computeSubmitted;
         Semaphore* semaphore;
-        Fence* fence;
-        bool fenceSignaled;
+        /**
+         * The number the frame was last submitted as, which the device's frame timeline reaches when the GPU has
+         * finished it. Zero once the device has waited for it.
+         */
+        uint64_t timelineValue;
         std::vector<Semaphore*> waitSemaphores;
         std::vector<Swapchain*> swapchainsToPresent;
+
+        /**
+         * Objects whose destruction was requested during the frame, which are destroyed once the GPU has finished
+         * it.
+         */
+        std::vector<Buffer*> buffersToDestroy;
+        std::vector<Image*> imagesToDestroy;
+        std::vector<Shader*> shadersToDestroy;
+        std::vector<Sampler*> samplersToDestroy;
     };
 }
@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Vixen {
+    /**
+     * How far the CPU may run ahead of the GPU, trading input latency against GPU utilization.
+     */
+    enum class FrameLatencyMode {
+        /**
+         * A frame waits for the GPU to finish the frame it reuses the resources of when it begins, so the CPU may
+         * queue as many frames as there are in flight.
+         */
+        Balanced,
+        /**
+         * Like balanced, but a frame also waits until the GPU has at most one frame left to finish, as late as it
+         * can: when the input of the frame is about to be sampled, or otherwise when it is submitted. The GPU keeps
+         * one frame queued while the next is recorded, so input is read as close to the frame being displayed as
+         * possible without the GPU idling.
+         */
+        LowLatency,
+        /**
+         * Like balanced, but swapchains have an image more than there are frames in flight, so acquiring an image
+         * never waits for presentation and the GPU always has queued work. Best combined with three or more frames
+         * in flight.
+         */
+        Throughput
+    };
+}
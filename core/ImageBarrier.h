@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "BarrierAccessFlags.h"
 #include "image/ImageLayout.h"
 #include "image/ImageSubresourceRange.h"
@@ -14,5 +16,7 @@ namespace Vixen {
         ImageLayout oldLayout;
         ImageLayout newLayout;
         ImageSubresourceRange subresources;
+        uint32_t sourceQueueFamily;
+        uint32_t destinationQueueFamily;
     };
 }
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace Vixen {
+    /**
+     * Rounds the value up to a multiple of the alignment, which need not be a power of two but must not be zero.
+     */
+    constexpr uint64_t alignUp(
+        const uint64_t value,
+        const uint64_t alignment
+    ) {
+        if (alignment == 0)
+            throw std::invalid_argument("Alignment must not be zero");
+
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
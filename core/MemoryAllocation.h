@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Vixen {
+    /**
+     * A block of device memory that images and buffers can be placed into at an offset, with several resources
+     * sharing the same range as long as they are never in use at the same time.
+     */
+    struct MemoryAllocation {
+        uint64_t size = 0;
+
+        virtual ~MemoryAllocation() = default;
+    };
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Vixen {
+    struct MemoryRequirements {
+        uint64_t size = 0;
+        uint64_t alignment = 1;
+        uint32_t memoryTypeBits = 0;
+
+        bool operator==(const MemoryRequirements& other) const = default;
+    };
+}
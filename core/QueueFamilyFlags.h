@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 
 #include "Bitmask.h"
 
@@ -15,4 +16,9 @@ namespace Vixen {
     struct EnableFlags<QueueFamilyBits> : std::true_type {};
 
     using QueueFamilyFlags = Flags<QueueFamilyBits>;
+
+    /**
+     * Used as both queue families of a barrier that does not transfer ownership of its resource between queues.
+     */
+    constexpr uint32_t QueueFamilyIgnored = std::numeric_limits<uint32_t>::max();
 }
@@ -2,23 +2,119 @@
 
 #include <algorithm>
 #include <ranges>
+#include <stdexcept>
 #include <spdlog/spdlog.h>
 
 #include "RenderingContextDriver.h"
 #include "RenderingDeviceDriver.h"
+#include "buffer/StagingRing.h"
+#include "buffer/UniformAllocator.h"
 #include "error/CantCreateError.h"
 #include "error/Macros.h"
 #include "error/SwapchainError.h"
+#include "framegraph/FrameGraph.h"
+#include "framegraph/FrameGraphArena.h"
+#include "framegraph/FrameGraphResourcePool.h"
+#include "framegraph/FrameGraphCache.h"
+#include "framegraph/FrameGraphProfiler.h"
+#include "framegraph/ParallelPassRecorder.h"
 
 namespace Vixen {
+    void RenderingDevice::createFrames(
+        const uint32_t count
+    ) {
+        frames.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            const auto commandPool = renderingDeviceDriver->createCommandPool(
+                graphicsQueueFamily,
+                CommandBufferType::Primary
+            );
+            if (!commandPool)
+                throw CantCreateError("Failed to allocate command pool for frame");
+
+            CommandPool* computeCommandPool = nullptr;
+            CommandBuffer* computeCommandBuffer = nullptr;
+            CommandBuffer* commandBufferAfterCompute = nullptr;
+            if (computeQueue) {
+                const auto pool = renderingDeviceDriver->createCommandPool(
+                    computeQueueFamily,
+                    CommandBufferType::Primary
+                );
+                if (!pool)
+                    throw CantCreateError("Failed to allocate compute command pool for frame");
+
+                computeCommandPool = pool.value();
+                computeCommandBuffer = renderingDeviceDriver->createCommandBuffer(computeCommandPool).value();
+                commandBufferAfterCompute = renderingDeviceDriver->createCommandBuffer(commandPool.value()).value();
+            }
+
+            frames.push_back(
+                {
+                    .commandPool = commandPool.value(),
+                    .commandBuffer = renderingDeviceDriver->createCommandBuffer(commandPool.value()).value(),
+                    .commandBufferAfterCompute = commandBufferAfterCompute,
+                    .computeCommandPool = computeCommandPool,
+                    .computeCommandBuffer = computeCommandBuffer,
+                    .computeSubmitted = false,
+                    .semaphore = renderingDeviceDriver->createSemaphore().value(),
+                    .timelineValue = 0,
+                    .waitSemaphores = {},
+                    .swapchainsToPresent = {},
+                    .buffersToDestroy = {},
+                    .imagesToDestroy = {},
+                    .shadersToDestroy = {},
+                    .samplersToDestroy = {}
+                }
+            );
+        }
+    }
+
+    void RenderingDevice::destroyFrames() {
+        for (auto& frame : frames) {
+            destroyQueuedObjects(frame);
+
+            renderingDeviceDriver->destroyCommandPool(frame.commandPool);
+            renderingDeviceDriver->destroySemaphore(frame.semaphore);
+            delete frame.commandBuffer;
+            delete frame.commandBufferAfterCompute;
+
+            if (frame.computeCommandPool)
+                renderingDeviceDriver->destroyCommandPool(frame.computeCommandPool);
+            delete frame.computeCommandBuffer;
+        }
+        frames.clear();
+    }
+
+    void RenderingDevice::destroyQueuedObjects(
+        Frame& frame
+    ) {
+        for (const auto buffer : frame.buffersToDestroy)
+            renderingDeviceDriver->destroyBuffer(buffer);
+        frame.buffersToDestroy.clear();
+
+        for (const auto image : frame.imagesToDestroy)
+            renderingDeviceDriver->destroyImage(image);
+        frame.imagesToDestroy.clear();
+
+        for (const auto shader : frame.shadersToDestroy)
+            renderingDeviceDriver->destroyShader(shader);
+        frame.shadersToDestroy.clear();
+
+        for (const auto sampler : frame.samplersToDestroy)
+            renderingDeviceDriver->destroySampler(sampler);
+        frame.samplersToDestroy.clear();
+    }
+
     void RenderingDevice::waitForFrame(
         const uint32_t frameIndex
     ) {
-        if (!frames[frameIndex].fenceSignaled)
+        if (frames[frameIndex].timelineValue == 0)
             return;
 
-        renderingDeviceDriver->waitOnFence(frames[frameIndex].fence).value();
-        frames[frameIndex].fenceSignaled = false;
+        waitForFrameCompletion(frames[frameIndex].timelineValue);
+        frames[frameIndex].timelineValue = 0;
+
+        frameGraphProfiler->resolveFrame(frameIndex);
     }
 
     void RenderingDevice::waitForFrames() {
@@ -30,20 +126,43 @@ namespace Vixen {
         waitForFrames();
         endFrame();
         executeFrame(false);
-        beginFrame(false);
+
+        // The frame carries on, so its queries are left to be resolved when it is submitted for the last time
+        waitForFrameCompletion(frames[frameIndex].timelineValue);
+        frames[frameIndex].timelineValue = 0;
+
+        beginFrameCommands();
     }
 
-    void RenderingDevice::beginFrame(
-        const bool presented
-    ) {
-        waitForFrame(frameIndex);
+    void RenderingDevice::beginFrameCommands() {
+        destroyQueuedObjects(frames[frameIndex]);
 
         if (!renderingDeviceDriver->resetCommandPool(frames[frameIndex].commandPool))
             throw std::runtime_error("Failed to reset command pool");
+        if (computeQueue && !renderingDeviceDriver->resetCommandPool(frames[frameIndex].computeCommandPool))
+            throw std::runtime_error("Failed to reset compute command pool");
+        frames[frameIndex].computeSubmitted = false;
         if (!renderingDeviceDriver->beginCommandBuffer(frames[frameIndex].commandBuffer))
             throw std::runtime_error("Failed to begin command buffer");
+    }
+
+    void RenderingDevice::recycleFrame() {
+        frameGraphArena->reset();
+        parallelPassRecorder->beginFrame(frameIndex);
+        frameGraphProfiler->beginFrame(frameIndex);
+        stagingRing->beginFrame(frameIndex);
+        uniformAllocator->beginFrame(frameIndex);
+    }
+
+    void RenderingDevice::beginFrame(
+        const bool presented
+    ) {
+        waitForFrame(frameIndex);
+        framePaced = false;
+        beginFrameCommands();
 
-        // TODO: Free this frame's resources
+        frameGraphResourcePool->beginFrame();
+        recycleFrame();
     }
 
     void RenderingDevice::endFrame() {
@@ -52,7 +171,6 @@ namespace Vixen {
 
     void RenderingDevice::executeChainedCommands(
         const bool present,
-        Fence* drawFence,
         Semaphore* drawSemaphoreToSignal
     ) {
         if (!renderingDeviceDriver->executeCommandQueueAndPresent(
@@ -62,9 +180,9 @@ namespace Vixen {
                 ? std::vector{frames[frameIndex].commandBuffer}
                 : std::vector<CommandBuffer*>{},
             drawSemaphoreToSignal
-                ? std::vector{drawSemaphoreToSignal}
-                : std::vector<Semaphore*>{},
-            drawFence,
+                ? std::vector{drawSemaphoreToSignal, frameTimeline}
+                : std::vector{frameTimeline},
+            nullptr,
             present
                 ? frames[frameIndex].swapchainsToPresent
                 : std::vector<Swapchain*>{}
@@ -83,8 +201,9 @@ namespace Vixen {
         Semaphore* semaphore = canPresent && separatePresentQueue ? frames[frameIndex].semaphore : nullptr;
         const bool presentSwapchain = canPresent && !separatePresentQueue;
 
-        executeChainedCommands(presentSwapchain, frames[frameIndex].fence, semaphore);
-        frames[frameIndex].fenceSignaled = true;
+        waitForFramePacing();
+        executeChainedCommands(presentSwapchain, semaphore);
+        frames[frameIndex].timelineValue = ++framesSubmitted;
 
         if (canPresent) {
             if (separatePresentQueue) {
@@ -104,9 +223,16 @@ namespace Vixen {
 
     RenderingDevice::RenderingDevice(
         RenderingContextDriver* renderingContext,
-        Window* mainWindow
+        Window* mainWindow,
+        const uint32_t framesInFlight,
+        const FrameLatencyMode latencyMode
     ) : renderingContextDriver(renderingContext),
-        frameIndex(0) {
+        frameIndex(0),
+        latencyMode(latencyMode),
+        framePaced(false) {
+        if (framesInFlight < MinFramesInFlight || framesInFlight > MaxFramesInFlight)
+            throw std::invalid_argument("Frames in flight must be between 1 and 4");
+
         Surface* mainSurface = renderingContextDriver->getSurfaceFromWindow(mainWindow);
 
         const auto devices = renderingContextDriver->getDevices();
@@ -121,7 +247,7 @@ namespace Vixen {
                 "            * Supports presentation? {}",
                 i,
                 devices[i].name,
-                renderingContext->deviceSupportsPresent(i, mainSurface) ? "Yes" : "No"
+                mainSurface != nullptr && renderingContext->deviceSupportsPresent(i, mainSurface) ? "Yes" : "No"
             );
         }
         spdlog::trace("Found the following devices.\n{}", deviceList);
@@ -132,7 +258,7 @@ namespace Vixen {
             const auto& deviceOption = devices[i];
             const bool supportsPresent = mainSurface != nullptr
                                              ? renderingContext->deviceSupportsPresent(i, mainSurface)
-                                             : false;
+                                             : mainWindow == nullptr;
 
             if (!supportsPresent)
                 continue;
@@ -169,10 +295,8 @@ namespace Vixen {
         if (deviceIndex == std::numeric_limits<uint32_t>::max())
             error<CantCreateError>("No suitable device found.");
 
-        uint32_t frameCount = 2;
-
         device = devices[deviceIndex];
-        renderingDeviceDriver = renderingContext->createRenderingDeviceDriver(deviceIndex, frameCount);
+        renderingDeviceDriver = renderingContext->createRenderingDeviceDriver(deviceIndex, framesInFlight);
 
         graphicsQueueFamily = renderingDeviceDriver->getQueueFamily(
             QueueFamilyBits::Graphics | QueueFamilyBits::Compute,
@@ -183,32 +307,46 @@ namespace Vixen {
         transferQueueFamily = renderingDeviceDriver->getQueueFamily(QueueFamilyBits::Transfer, nullptr).value();
         transferQueue = renderingDeviceDriver->createCommandQueue(transferQueueFamily).value();
 
-        presentQueueFamily = renderingDeviceDriver->getQueueFamily(static_cast<QueueFamilyFlags>(0), mainSurface)
-                                                  .value();
-        presentQueue = renderingDeviceDriver->createCommandQueue(presentQueueFamily).value();
-
-        frames.reserve(frameCount);
-        for (uint32_t i = 0; i < frameCount; i++) {
-            const auto commandPool = renderingDeviceDriver->createCommandPool(
-                graphicsQueueFamily,
-                CommandBufferType::Primary
-            );
-            if (!commandPool)
-                throw CantCreateError("Failed to allocate command pool for frame");
+        if (mainSurface != nullptr) {
+            presentQueueFamily = renderingDeviceDriver->getQueueFamily(static_cast<QueueFamilyFlags>(0), mainSurface)
+                                                      .value();
+            presentQueue = renderingDeviceDriver->createCommandQueue(presentQueueFamily).value();
+        } else {
+            presentQueueFamily = graphicsQueueFamily;
+            presentQueue = graphicsQueue;
+        }
 
-            frames.push_back(
-                {
-                    .commandPool = commandPool.value(),
-                    .commandBuffer = renderingDeviceDriver->createCommandBuffer(commandPool.value()).value(),
-                    .semaphore = renderingDeviceDriver->createSemaphore().value(),
-                    .fence = renderingDeviceDriver->createFence().value(),
-                    .fenceSignaled = false,
-                    .waitSemaphores = {},
-                    .swapchainsToPresent = {}
-                }
-            );
+        computeQueueFamily = graphicsQueueFamily;
+        computeQueue = nullptr;
+        computeSemaphore = nullptr;
+        if (device.hasDedicatedComputeQueue) {
+            computeQueueFamily = renderingDeviceDriver->getQueueFamily(QueueFamilyBits::Compute, nullptr).value();
+            if (computeQueueFamily != graphicsQueueFamily) {
+                computeQueue = renderingDeviceDriver->createCommandQueue(computeQueueFamily).value();
+                computeSemaphore = renderingDeviceDriver->createSemaphore().value();
+            }
         }
-        framesDrawn = frames.size();
+
+        frameTimeline = renderingDeviceDriver->createSemaphore().value();
+        framesSubmitted = 0;
+        createFrames(framesInFlight);
+
+        frameGraphResourcePool = std::make_unique<FrameGraphResourcePool>(*renderingDeviceDriver, framesInFlight);
+        frameGraphCache = std::make_unique<FrameGraphCache>();
+        frameGraphArena = std::make_unique<FrameGraphArena>();
+        parallelPassRecorder = std::make_unique<ParallelPassRecorder>(
+            *renderingDeviceDriver,
+            graphicsQueueFamily,
+            framesInFlight
+        );
+        frameGraphProfiler = std::make_unique<FrameGraphProfiler>(*renderingDeviceDriver, framesInFlight);
+        stagingRing = std::make_unique<StagingRing>(*renderingDeviceDriver, framesInFlight);
+        uniformAllocator = std::make_unique<UniformAllocator>(
+            *renderingDeviceDriver,
+            framesInFlight,
+            device.uniformBufferOffsetAlignment,
+            device.maxUniformBufferRange
+        );
 
         renderingDeviceDriver->beginCommandBuffer(frames[0].commandBuffer);
     }
@@ -217,13 +355,16 @@ namespace Vixen {
         if (!frames.empty())
             flushAndWaitForFrames();
 
-        for (const auto& frame : frames) {
-            renderingDeviceDriver->destroyCommandPool(frame.commandPool);
-            renderingDeviceDriver->destroySemaphore(frame.semaphore);
-            renderingDeviceDriver->destroyFence(frame.fence);
-            delete frame.commandBuffer;
-        }
-        frames.clear();
+        destroyFrames();
+        renderingDeviceDriver->destroySemaphore(frameTimeline);
+
+        frameGraphResourcePool.reset();
+        frameGraphCache.reset();
+        frameGraphArena.reset();
+        parallelPassRecorder.reset();
+        frameGraphProfiler.reset();
+        stagingRing.reset();
+        uniformAllocator.reset();
 
         if (presentQueue)
             if (graphicsQueue != presentQueue)
@@ -233,6 +374,11 @@ namespace Vixen {
             if (graphicsQueue != transferQueue)
                 renderingDeviceDriver->destroyCommandQueue(transferQueue);
 
+        if (computeQueue) {
+            renderingDeviceDriver->destroyCommandQueue(computeQueue);
+            renderingDeviceDriver->destroySemaphore(computeSemaphore);
+        }
+
         if (graphicsQueue)
             renderingDeviceDriver->destroyCommandQueue(graphicsQueue);
 
@@ -259,6 +405,97 @@ namespace Vixen {
         beginFrame(true);
     }
 
+    void RenderingDevice::executeFrameGraph(
+        FrameGraph& graph
+    ) {
+        auto& frame = frames[frameIndex];
+        graph.setProfiler(*frameGraphProfiler);
+
+        if (!computeQueue || frame.computeSubmitted) {
+            if (!graph.isCompiled())
+                graph.compile(*frameGraphCache, {.graphicsQueueFamily = graphicsQueueFamily});
+
+            graph.execute(*frameGraphResourcePool, frame.commandBuffer);
+            return;
+        }
+
+        const auto& plan = graph.isCompiled()
+                               ? graph.getCompiled()
+                               : graph.compile(*frameGraphCache, {
+                                   .graphicsQueueFamily = graphicsQueueFamily,
+                                   .asyncComputeQueueFamily = computeQueueFamily
+                               });
+        if (!plan.hasAsyncCompute()) {
+            graph.execute(*frameGraphResourcePool, frame.commandBuffer);
+            return;
+        }
+
+        if (!renderingDeviceDriver->beginCommandBuffer(frame.computeCommandBuffer))
+            throw std::runtime_error("Failed to begin compute command buffer");
+        if (!renderingDeviceDriver->beginCommandBuffer(frame.commandBufferAfterCompute))
+            throw std::runtime_error("Failed to begin command buffer");
+
+        graph.execute(
+            *frameGraphResourcePool,
+            {
+                .graphics = frame.commandBuffer,
+                .asyncCompute = frame.computeCommandBuffer,
+                .graphicsAfterAsyncCompute = frame.commandBufferAfterCompute
+            }
+        );
+
+        renderingDeviceDriver->endCommandBuffer(frame.computeCommandBuffer);
+        if (!renderingDeviceDriver->executeCommandQueueAndPresent(
+            computeQueue,
+            {},
+            {frame.computeCommandBuffer},
+            {computeSemaphore},
+            nullptr,
+            {}
+        ))
+            throw std::runtime_error("Failed to execute compute commands");
+
+        // Everything recorded so far can start right away, the rest of the frame waits for the compute work
+        renderingDeviceDriver->endCommandBuffer(frame.commandBuffer);
+        if (!renderingDeviceDriver->executeCommandQueueAndPresent(
+            graphicsQueue,
+            frame.waitSemaphores,
+            {frame.commandBuffer},
+            {},
+            nullptr,
+            {}
+        ))
+            throw std::runtime_error("Failed to execute graphics commands");
+
+        frame.waitSemaphores = {computeSemaphore};
+        std::swap(frame.commandBuffer, frame.commandBufferAfterCompute);
+        frame.computeSubmitted = true;
+    }
+
+    void RenderingDevice::destroyBuffer(
+        Buffer* buffer
+    ) {
+        frames[frameIndex].buffersToDestroy.push_back(buffer);
+    }
+
+    void RenderingDevice::destroyImage(
+        Image* image
+    ) {
+        frames[frameIndex].imagesToDestroy.push_back(image);
+    }
+
+    void RenderingDevice::destroyShader(
+        Shader* shader
+    ) {
+        frames[frameIndex].shadersToDestroy.push_back(shader);
+    }
+
+    void RenderingDevice::destroySampler(
+        Sampler* sampler
+    ) {
+        frames[frameIndex].samplersToDestroy.push_back(sampler);
+    }
+
     auto RenderingDevice::createScreen(
         Window* window
     ) -> std::expected<Swapchain*, Error> {
@@ -301,7 +538,7 @@ namespace Vixen {
         if (!framebuffer && framebuffer.error() == SwapchainError::ResizeRequired) {
             flushAndWaitForFrames();
 
-            if (!renderingDeviceDriver->resizeSwapchain(graphicsQueue, swapchain, frames.size()))
+            if (!renderingDeviceDriver->resizeSwapchain(graphicsQueue, swapchain, getSwapchainImageCount()))
                 return std::unexpected(Error::InitializationFailed);
 
             framebuffer = renderingDeviceDriver->acquireSwapchainFramebuffer(graphicsQueue, swapchain);
@@ -328,6 +565,100 @@ namespace Vixen {
         swapchains.erase(window);
     }
 
+    uint32_t RenderingDevice::getSwapchainImageCount() const {
+        return frames.size() + (latencyMode == FrameLatencyMode::Throughput ? 1 : 0);
+    }
+
+    void RenderingDevice::requestSwapchainResize() const {
+        for (const auto& window : swapchains | std::views::keys)
+            if (const auto surface = renderingContextDriver->getSurfaceFromWindow(window); surface != nullptr)
+                renderingContextDriver->setSurfaceNeedsResize(surface, true);
+    }
+
+    void RenderingDevice::setFramesInFlight(
+        const uint32_t count
+    ) {
+        if (count < MinFramesInFlight || count > MaxFramesInFlight)
+            throw std::invalid_argument("Frames in flight must be between 1 and 4");
+
+        if (count == frames.size())
+            return;
+
+        // The frames being rebuilt may not be in use by the GPU, including the one recorded so far
+        waitForFrames();
+        endFrame();
+        executeFrame(false);
+        waitForFrame(frameIndex);
+
+        destroyFrames();
+        createFrames(count);
+        frameIndex = 0;
+
+        frameGraphResourcePool->setFramesInFlight(count);
+        parallelPassRecorder->setFramesInFlight(count);
+        frameGraphProfiler->setFramesInFlight(count);
+        stagingRing->setFramesInFlight(count);
+        uniformAllocator->setFramesInFlight(count);
+        requestSwapchainResize();
+
+        // The frame carries on with the new frames, so the pool stays on the same frame and histories do not swap
+        beginFrameCommands();
+        recycleFrame();
+    }
+
+    uint64_t RenderingDevice::getSubmittedFrame() const {
+        return framesSubmitted;
+    }
+
+    uint64_t RenderingDevice::getCompletedFrame() const {
+        return renderingDeviceDriver->getSemaphoreValue(frameTimeline).value();
+    }
+
+    bool RenderingDevice::isFrameCompleted(
+        const uint64_t frame
+    ) const {
+        return getCompletedFrame() >= frame;
+    }
+
+    void RenderingDevice::waitForFrameCompletion(
+        const uint64_t frame
+    ) const {
+        if (frame > framesSubmitted)
+            throw std::invalid_argument("Cannot wait for a frame that has not been submitted");
+
+        renderingDeviceDriver->waitOnSemaphore(frameTimeline, frame).value();
+    }
+
+    void RenderingDevice::waitForFramePacing() {
+        if (latencyMode != FrameLatencyMode::LowLatency || framePaced)
+            return;
+
+        framePaced = true;
+        if (framesSubmitted > 1)
+            waitForFrameCompletion(framesSubmitted - 1);
+    }
+
+    Semaphore* RenderingDevice::getFrameTimeline() const {
+        return frameTimeline;
+    }
+
+    uint32_t RenderingDevice::getFramesInFlight() const {
+        return frames.size();
+    }
+
+    void RenderingDevice::setFrameLatencyMode(
+        const FrameLatencyMode mode
+    ) {
+        const auto imageCount = getSwapchainImageCount();
+        latencyMode = mode;
+        if (getSwapchainImageCount() != imageCount)
+            requestSwapchainResize();
+    }
+
+    FrameLatencyMode RenderingDevice::getFrameLatencyMode() const {
+        return latencyMode;
+    }
+
     RenderingContextDriver* RenderingDevice::getRenderingContextDriver() const {
         return renderingContextDriver;
     }
@@ -335,4 +666,32 @@ namespace Vixen {
     RenderingDeviceDriver* RenderingDevice::getRenderingDeviceDriver() const {
         return renderingDeviceDriver;
     }
+
+    FrameGraphResourcePool& RenderingDevice::getFrameGraphResourcePool() const {
+        return *frameGraphResourcePool;
+    }
+
+    ParallelPassRecorder& RenderingDevice::getParallelPassRecorder() const {
+        return *parallelPassRecorder;
+    }
+
+    FrameGraphCache& RenderingDevice::getFrameGraphCache() const {
+        return *frameGraphCache;
+    }
+
+    FrameGraphArena& RenderingDevice::getFrameGraphArena() const {
+        return *frameGraphArena;
+    }
+
+    FrameGraphProfiler& RenderingDevice::getFrameGraphProfiler() const {
+        return *frameGraphProfiler;
+    }
+
+    StagingRing& RenderingDevice::getStagingRing() const {
+        return *stagingRing;
+    }
+
+    UniformAllocator& RenderingDevice::getUniformAllocator() const {
+        return *uniformAllocator;
+    }
 }
@@ -3,10 +3,12 @@
 #include <cstdint>
 #include <expected>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "DriverDevice.h"
 #include "Frame.h"
+#include "FrameLatencyMode.h"
 #include "error/Error.h"
 
 namespace Vixen {
@@ -15,6 +17,14 @@ namespace Vixen {
     class RenderingDeviceDriver;
     struct Window;
     struct CommandQueue;
+    class FrameGraph;
+    class FrameGraphArena;
+    class FrameGraphCache;
+    class FrameGraphProfiler;
+    class FrameGraphResourcePool;
+    class ParallelPassRecorder;
+    class StagingRing;
+    class UniformAllocator;
 
     class RenderingDevice {
         RenderingContextDriver* renderingContextDriver;
@@ -25,24 +35,78 @@ namespace Vixen {
         uint32_t graphicsQueueFamily;
         uint32_t transferQueueFamily;
         uint32_t presentQueueFamily;
+        uint32_t computeQueueFamily;
         CommandQueue* graphicsQueue;
         CommandQueue* transferQueue;
         CommandQueue* presentQueue;
+        CommandQueue* computeQueue;
+        Semaphore* computeSemaphore;
+
+        /**
+         * Signalled by the graphics queue with the number of every frame it finishes.
+         */
+        Semaphore* frameTimeline;
+        /**
+         * The number of the last frame submitted, frames are numbered from one.
+         */
+        uint64_t framesSubmitted;
 
         uint32_t frameIndex;
         std::vector<Frame> frames;
-        uint64_t framesDrawn;
+        FrameLatencyMode latencyMode;
+        /**
+         * Whether the current frame has already waited for the GPU to catch up in low latency mode.
+         */
+        bool framePaced;
 
         std::map<Window*, Swapchain*> swapchains;
 
+        std::unique_ptr<FrameGraphResourcePool> frameGraphResourcePool;
+        std::unique_ptr<FrameGraphCache> frameGraphCache;
+        std::unique_ptr<FrameGraphArena> frameGraphArena;
+        std::unique_ptr<ParallelPassRecorder> parallelPassRecorder;
+        std::unique_ptr<FrameGraphProfiler> frameGraphProfiler;
+        std::unique_ptr<StagingRing> stagingRing;
+        std::unique_ptr<UniformAllocator> uniformAllocator;
+
+        void createFrames(
+            uint32_t count
+        );
+
+        void destroyFrames();
+
+        /**
+         * Destroys the objects queued for destruction during the frame, which the GPU must have finished.
+         */
+        void destroyQueuedObjects(
+            Frame& frame
+        );
+
         void waitForFrame(
             uint32_t frameIndex
         );
 
         void waitForFrames();
 
+        /**
+         * Submits the commands recorded so far and waits for the GPU to become idle, then carries on recording the
+         * same frame. Nothing allocated for the frame is recycled, and its queries are resolved once the frame is
+         * really submitted.
+         */
         void flushAndWaitForFrames();
 
+        /**
+         * Destroys the objects queued by the frame and begins its command buffer again. The GPU must have finished
+         * every command buffer recorded for the frame.
+         */
+        void beginFrameCommands();
+
+        /**
+         * Reclaims the per-frame memory of the frame graph arena, recorder, profiler, staging ring and uniform
+         * allocator. Only called when a frame begins, never when a frame is flushed halfway.
+         */
+        void recycleFrame();
+
         void beginFrame(
             bool presented
         );
@@ -51,7 +115,6 @@ namespace Vixen {
 
         void executeChainedCommands(
             bool present,
-            Fence* drawFence,
             Semaphore* drawSemaphoreToSignal
         );
 
@@ -59,10 +122,29 @@ namespace Vixen {
             bool present
         );
 
+        [[nodiscard]] uint32_t getSwapchainImageCount() const;
+
+        /**
+         * Makes every screen resize its swapchain before it is next drawn to, so it has as many images as needed.
+         */
+        void requestSwapchainResize() const;
+
     public:
+        static constexpr uint32_t MinFramesInFlight = 1;
+
+        static constexpr uint32_t MaxFramesInFlight = 4;
+
+        /**
+         * Creates a device able to present to the main window, or a headless one that never presents when there is no
+         * main window, such as one created with the null context driver for benchmarks.
+         * @param framesInFlight The number of frames the CPU may record while the GPU is still working on earlier
+         * ones, between MinFramesInFlight and MaxFramesInFlight.
+         */
         RenderingDevice(
             RenderingContextDriver* renderingContext,
-            Window* mainWindow
+            Window* mainWindow,
+            uint32_t framesInFlight = 2,
+            FrameLatencyMode latencyMode = FrameLatencyMode::Balanced
         );
 
         ~RenderingDevice();
@@ -75,20 +157,173 @@ namespace Vixen {
 
         void sync();
 
+        /**
+         * Records the frame graph into the current frame, measuring the GPU time of its passes. On devices with a
+         * dedicated compute queue, the compute passes that depend on no graphics work are submitted to it right away,
+         * along with the graphics passes that can run alongside them, while the rest of the frame waits for the
+         * compute work to finish. Only the first graph of a frame is scheduled this way, later ones run entirely on
+         * the graphics queue.
+         */
+        void executeFrameGraph(
+            FrameGraph& graph
+        );
+
+        /**
+         * Queues the buffer for destruction once the GPU has finished every frame that may use it, which is when the
+         * current frame's resources are next reused, so it can be released at any time without waiting for the GPU.
+         */
+        void destroyBuffer(
+            Buffer* buffer
+        );
+
+        /**
+         * Queues the image for destruction once the GPU has finished the current frame, like destroyBuffer.
+         */
+        void destroyImage(
+            Image* image
+        );
+
+        /**
+         * Queues the shader for destruction once the GPU has finished the current frame, like destroyBuffer.
+         */
+        void destroyShader(
+            Shader* shader
+        );
+
+        /**
+         * Queues the sampler for destruction once the GPU has finished the current frame, like destroyBuffer.
+         */
+        void destroySampler(
+            Sampler* sampler
+        );
+
         auto createScreen(
             Window* window
         ) -> std::expected<Swapchain*, Error>;
 
+        /**
+         * Acquires the next framebuffer of the window's swapchain and queues it for presenting with the frame. When
+         * the swapchain has to be resized first, the commands recorded so far are flushed, but the frame carries on
+         * and everything allocated for it stays valid.
+         */
         auto prepareScreenForDrawing(
             Window* window
         ) -> std::expected<Framebuffer*, Error>;
 
+        /**
+         * Flushes the commands recorded so far, waits for the GPU to become idle and destroys the window's swapchain.
+         * The frame carries on, and everything allocated for it stays valid.
+         */
         void destroyScreen(
             Window* window
         );
 
+        /**
+         * Submits the commands recorded so far, waits for the GPU to become idle, and rebuilds the frames along with
+         * the per-frame state of the frame graph pool, recorder and profiler, the staging ring and the uniform
+         * allocator. Screens resize their swapchains before they are next drawn to. No frame graph executed this frame
+         * may still be alive, and staging space and uniform slices allocated this frame are reclaimed. The frame itself
+         * carries on, so frame graph histories do not swap.
+         */
+        void setFramesInFlight(
+            uint32_t count
+        );
+
+        [[nodiscard]] uint32_t getFramesInFlight() const;
+
+        /**
+         * The number of the last frame submitted to the GPU. Frames are numbered from one in the order they are
+         * submitted.
+         */
+        [[nodiscard]] uint64_t getSubmittedFrame() const;
+
+        /**
+         * The number of the last frame the GPU has finished, along with every frame before it. Polls the frame
+         * timeline without waiting.
+         */
+        [[nodiscard]] uint64_t getCompletedFrame() const;
+
+        [[nodiscard]] bool isFrameCompleted(
+            uint64_t frame
+        ) const;
+
+        /**
+         * Waits until the GPU has finished the frame, which must have been submitted.
+         */
+        void waitForFrameCompletion(
+            uint64_t frame
+        ) const;
+
+        /**
+         * In low latency mode, waits until the GPU has at most the last submitted frame left to finish, so no more
+         * than one frame is ever queued. Call it right before sampling the input of the frame, otherwise the frame
+         * waits when it is submitted. Does nothing in other modes, or when the frame has already waited.
+         */
+        void waitForFramePacing();
+
+        /**
+         * The timeline semaphore the GPU signals with the number of every frame it finishes. A submission to another
+         * queue waiting on it waits for the last frame submitted.
+         */
+        [[nodiscard]] Semaphore* getFrameTimeline() const;
+
+        /**
+         * Takes effect from the next frame. Screens resize their swapchains if the mode needs a different number of
+         * images.
+         */
+        void setFrameLatencyMode(
+            FrameLatencyMode mode
+        );
+
+        [[nodiscard]] FrameLatencyMode getFrameLatencyMode() const;
+
         [[nodiscard]] RenderingContextDriver* getRenderingContextDriver() const;
 
         [[nodiscard]] RenderingDeviceDriver* getRenderingDeviceDriver() const;
+
+        /**
+         * The pool frame graphs executed on this device should take their physical resources from. It advances with
+         * every frame, so resources released by a graph are reused once the frame they were used in has completed.
+         */
+        [[nodiscard]] FrameGraphResourcePool& getFrameGraphResourcePool() const;
+
+        /**
+         * The recorder frame graphs executed on this device can record their passes in parallel with. Its command
+         * pools are reset along with the frame they belong to.
+         */
+        [[nodiscard]] ParallelPassRecorder& getParallelPassRecorder() const;
+
+        /**
+         * The cache frame graphs executed on this device are compiled with, so graphs rebuilt every frame with the
+         * same structure reuse the plan compiled for the first of them.
+         */
+        [[nodiscard]] FrameGraphCache& getFrameGraphCache() const;
+
+        /**
+         * The arena frame graphs built for the current frame should allocate from. It is reset when the next frame
+         * begins, so graphs built with it must be destroyed before then. Flushes in the middle of a frame, such as
+         * when a swapchain is resized or a screen is destroyed, leave it alone.
+         */
+        [[nodiscard]] FrameGraphArena& getFrameGraphArena() const;
+
+        /**
+         * The profiler measuring the GPU time of the passes of frame graphs executed on this device. The times of a
+         * frame are added once the device has waited for it.
+         */
+        [[nodiscard]] FrameGraphProfiler& getFrameGraphProfiler() const;
+
+        /**
+         * The ring uploads to the GPU take their staging space from. Space allocated during a frame stays valid until
+         * the GPU has finished the frame, so copies from it must be recorded into the frame's commands. Flushes in
+         * the middle of a frame do not reclaim it.
+         */
+        [[nodiscard]] StagingRing& getStagingRing() const;
+
+        /**
+         * The allocator constants that only live for a frame, such as those of a single draw, take their slices of
+         * uniform buffers from. Slices are aligned for binding with dynamic offsets and reused once the GPU has
+         * finished the frame, never by a flush in the middle of it.
+         */
+        [[nodiscard]] UniformAllocator& getUniformAllocator() const;
     };
 }
@@ -3,12 +3,17 @@
 #include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "BufferBarrier.h"
+#include "EventWait.h"
 #include "ImageBarrier.h"
 #include "MemoryBarrier.h"
+#include "MemoryRequirements.h"
 #include "PipelineStageFlags.h"
 #include "QueueFamilyFlags.h"
 #include "buffer/BufferUsage.h"
@@ -38,6 +43,8 @@ namespace Vixen {
     struct CommandPool;
     enum class CommandBufferType;
     struct Semaphore;
+    struct Event;
+    struct QueryPool;
     class Fence;
     enum class SwapchainError;
     enum class Error;
@@ -46,6 +53,7 @@ namespace Vixen {
     class Swapchain;
     struct CommandQueue;
     struct Framebuffer;
+    struct MemoryAllocation;
 
     class RenderingDeviceDriver {
     protected:
@@ -86,12 +94,57 @@ namespace Vixen {
             Fence* fence
         ) = 0;
 
+        /**
+         * Creates a timeline semaphore starting at zero. Every submission signalling it advances it by one.
+         */
         virtual auto createSemaphore() -> std::expected<Semaphore*, Error> = 0;
 
+        /**
+         * Waits on the host until the semaphore has reached at least the value.
+         */
+        virtual auto waitOnSemaphore(
+            Semaphore* semaphore,
+            uint64_t value
+        ) -> std::expected<void, Error> = 0;
+
+        /**
+         * The value the GPU has advanced the semaphore to so far, which can be polled without waiting.
+         */
+        virtual auto getSemaphoreValue(
+            Semaphore* semaphore
+        ) -> std::expected<uint64_t, Error> = 0;
+
         virtual void destroySemaphore(
             Semaphore* semaphore
         ) = 0;
 
+        virtual auto createEvent() -> std::expected<Event*, Error> = 0;
+
+        virtual void destroyEvent(
+            Event* event
+        ) = 0;
+
+        /**
+         * Creates a pool of timestamp queries.
+         */
+        virtual auto createQueryPool(
+            uint32_t count
+        ) -> std::expected<QueryPool*, Error> = 0;
+
+        /**
+         * Reads the timestamps of a range of queries in nanoseconds, or nullopt for queries that have not been written
+         * since they were last reset. The commands writing them must have completed.
+         */
+        virtual auto getQueryPoolResults(
+            QueryPool* pool,
+            uint32_t first,
+            uint32_t count
+        ) -> std::expected<std::vector<std::optional<uint64_t>>, Error> = 0;
+
+        virtual void destroyQueryPool(
+            QueryPool* pool
+        ) = 0;
+
         virtual auto createCommandPool(
             uint32_t queueFamily,
             CommandBufferType type
@@ -127,6 +180,18 @@ namespace Vixen {
             Buffer* buffer
         ) = 0;
 
+        /**
+         * Maps a buffer created with the CopySource or Uniform usage, whose memory is host coherent, so writes through
+         * the pointer need no flushing. Mapping a buffer that is already mapped returns the same pointer.
+         */
+        virtual std::byte* mapBuffer(
+            Buffer* buffer
+        ) = 0;
+
+        virtual void unmapBuffer(
+            Buffer* buffer
+        ) = 0;
+
         virtual auto getQueueFamily(
             QueueFamilyFlags queueFamilyFlags,
             Surface* surface
@@ -136,6 +201,12 @@ namespace Vixen {
             uint32_t queueFamilyIndex
         ) -> std::expected<CommandQueue*, Error> = 0;
 
+        /**
+         * Submits the command buffers, waiting for the last value each wait semaphore was signalled with and then
+         * signalling each signal semaphore with its next value, and presents the swapchains. The swapchain images
+         * acquired on the queue are released once the fence is waited on, or without a fence, once the last signal
+         * semaphore is waited on or polled past its new value.
+         */
         virtual auto executeCommandQueueAndPresent(
             CommandQueue* commandQueue,
             const std::vector<Semaphore*>& waitSemaphores,
@@ -154,6 +225,53 @@ namespace Vixen {
             const ImageView& view
         ) -> std::expected<Image*, Error> = 0;
 
+        virtual auto getBufferMemoryRequirements(
+            BufferUsageFlags usage,
+            uint32_t count,
+            uint32_t stride
+        ) -> std::expected<MemoryRequirements, Error> = 0;
+
+        virtual auto getImageMemoryRequirements(
+            const ImageFormat& format
+        ) -> std::expected<MemoryRequirements, Error> = 0;
+
+        /**
+         * Allocates device-local memory satisfying the requirements, for placing aliased buffers and images into.
+         */
+        virtual auto allocateMemory(
+            const MemoryRequirements& requirements
+        ) -> std::expected<MemoryAllocation*, Error> = 0;
+
+        /**
+         * Frees the memory. Every buffer and image placed into it must have been destroyed first.
+         */
+        virtual void freeMemory(
+            MemoryAllocation* allocation
+        ) = 0;
+
+        /**
+         * Creates a buffer bound to existing memory at the given offset. Destroying the buffer leaves the memory
+         * allocated.
+         */
+        virtual auto createAliasedBuffer(
+            BufferUsageFlags usage,
+            uint32_t count,
+            uint32_t stride,
+            MemoryAllocation* allocation,
+            uint64_t offset
+        ) -> std::expected<Buffer*, Error> = 0;
+
+        /**
+         * Creates an image bound to existing memory at the given offset. Destroying the image leaves the memory
+         * allocated.
+         */
+        virtual auto createAliasedImage(
+            const ImageFormat& format,
+            const ImageView& view,
+            MemoryAllocation* allocation,
+            uint64_t offset
+        ) -> std::expected<Image*, Error> = 0;
+
         virtual std::byte* mapImage(
             Image* image
         ) = 0;
@@ -202,6 +320,14 @@ namespace Vixen {
             CommandBuffer* commandBuffer
         ) = 0;
 
+        /**
+         * Records the secondary command buffers into the primary command buffer, in order.
+         */
+        virtual void commandExecuteCommandBuffers(
+            CommandBuffer* commandBuffer,
+            std::span<CommandBuffer* const> commandBuffers
+        ) = 0;
+
         virtual void commandSetViewport(
             CommandBuffer* commandBuffer,
             const std::vector<glm::uvec2>& viewports
@@ -230,9 +356,62 @@ namespace Vixen {
             CommandBuffer* commandBuffer,
             PipelineStageFlags sourceStages,
             PipelineStageFlags destinationStages,
-            const std::vector<MemoryBarrier>& memoryBarriers,
-            const std::vector<BufferBarrier>& bufferBarriers,
-            const std::vector<ImageBarrier>& imageBarriers
+            std::span<const MemoryBarrier> memoryBarriers,
+            std::span<const BufferBarrier> bufferBarriers,
+            std::span<const ImageBarrier> imageBarriers
+        ) = 0;
+
+        /**
+         * Records the first half of a split barrier, which signals the event once the commands before it have
+         * completed the source stages. The barriers must be the same ones the event is later waited on with.
+         */
+        virtual void commandSetEvent(
+            CommandBuffer* commandBuffer,
+            Event* event,
+            PipelineStageFlags sourceStages,
+            PipelineStageFlags destinationStages,
+            std::span<const MemoryBarrier> memoryBarriers,
+            std::span<const BufferBarrier> bufferBarriers,
+            std::span<const ImageBarrier> imageBarriers
+        ) = 0;
+
+        /**
+         * Records the second half of split barriers, which blocks the destination stages of the commands after it
+         * until every event has been signaled. Each event is waited on with the barriers it was signaled with.
+         */
+        virtual void commandWaitEvents(
+            CommandBuffer* commandBuffer,
+            std::span<const EventWait> waits
+        ) = 0;
+
+        /**
+         * Unsignals the event once the given stages of the commands before it have completed, so it can be signaled
+         * again.
+         */
+        virtual void commandResetEvent(
+            CommandBuffer* commandBuffer,
+            Event* event,
+            PipelineStageFlags stages
+        ) = 0;
+
+        /**
+         * Resets a range of queries so they can be written again. Must be recorded outside of a render pass.
+         */
+        virtual void commandResetQueryPool(
+            CommandBuffer* commandBuffer,
+            QueryPool* pool,
+            uint32_t first,
+            uint32_t count
+        ) = 0;
+
+        /**
+         * Writes the time at which the commands before it have completed the stage into the query.
+         */
+        virtual void commandWriteTimestamp(
+            CommandBuffer* commandBuffer,
+            QueryPool* pool,
+            PipelineStageBits stage,
+            uint32_t query
         ) = 0;
 
         virtual void commandClearBuffer(
@@ -294,9 +473,13 @@ namespace Vixen {
             const std::vector<BufferImageCopyRegion>& regions
         ) = 0;
 
+        /**
+         * Opens a debug label, which drivers drop when debugging tools are not attached. The label is copied, so it
+         * need not outlive the call.
+         */
         virtual void commandBeginLabel(
             CommandBuffer* commandBuffer,
-            const std::string& label,
+            std::string_view label,
             const glm::vec3& color
         ) = 0;
 
@@ -4,6 +4,10 @@ namespace Vixen {
     enum class RenderingDriver {
         Vulkan,
         D3D12,
-        OpenGL
+        OpenGL,
+        /**
+         * Runs without a GPU, only keeping track of the objects and commands it is given.
+         */
+        Null
     };
 }
@@ -12,6 +12,8 @@ namespace Vixen {
 
         BufferUsageFlags usage;
 
+        bool operator==(const BufferFormat& other) const = default;
+
         [[nodiscard]] uint64_t getSize() const noexcept {
             return static_cast<uint64_t>(count) * stride;
         }
@@ -0,0 +1,140 @@
+#include "StagingRing.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Buffer.h"
+#include "MemoryAlignment.h"
+#include "RenderingDeviceDriver.h"
+#include "error/Error.h"
+
+namespace Vixen {
+    StagingRing::StagingRing(
+        RenderingDeviceDriver& driver,
+        const uint32_t framesInFlight,
+        const uint64_t initialCapacity
+    ) : driver(driver),
+        initialCapacity(initialCapacity) {
+        frames.resize(framesInFlight);
+    }
+
+    StagingRing::~StagingRing() {
+        for (auto& frame : frames)
+            for (const auto retiredBuffer : frame.retiredBuffers)
+                destroyBuffer(retiredBuffer);
+
+        if (buffer)
+            destroyBuffer(buffer);
+    }
+
+    void StagingRing::beginFrame(
+        const uint32_t frameIndex
+    ) {
+        this->frameIndex = frameIndex;
+
+        auto& frame = frames[frameIndex];
+        used -= frame.size;
+        frame.size = 0;
+        if (used == 0)
+            head = 0;
+
+        for (const auto retiredBuffer : frame.retiredBuffers)
+            destroyBuffer(retiredBuffer);
+        frame.retiredBuffers.clear();
+    }
+
+    void StagingRing::setFramesInFlight(
+        const uint32_t count
+    ) {
+        for (auto& frame : frames)
+            for (const auto retiredBuffer : frame.retiredBuffers)
+                destroyBuffer(retiredBuffer);
+
+        frames.clear();
+        frames.resize(count);
+        frameIndex = 0;
+        head = 0;
+        used = 0;
+    }
+
+    auto StagingRing::allocate(
+        const uint64_t size,
+        const uint64_t alignment
+    ) -> std::expected<StagingAllocation, Error> {
+        if (alignment == 0)
+            return std::unexpected(Error::InitializationFailed);
+
+        uint64_t offset = alignUp(head, alignment);
+        // Allocations never straddle the end of the buffer, the space left there is skipped instead
+        if (offset + size > capacity)
+            offset = 0;
+        uint64_t padding = offset >= head ? offset - head : capacity - head;
+
+        if (buffer == nullptr || used + padding + size > capacity) {
+            if (!grow(size))
+                return std::unexpected(Error::InitializationFailed);
+
+            offset = 0;
+            padding = 0;
+        }
+
+        frames[frameIndex].size += padding + size;
+        used += padding + size;
+        head = offset + size;
+
+        return StagingAllocation{
+            .buffer = buffer,
+            .offset = offset,
+            .size = size,
+            .data = data + offset
+        };
+    }
+
+    auto StagingRing::grow(
+        const uint64_t size
+    ) -> std::expected<void, Error> {
+        uint64_t newCapacity = std::max(capacity * 2, initialCapacity);
+        while (newCapacity < size)
+            newCapacity *= 2;
+
+        if (newCapacity > std::numeric_limits<uint32_t>::max())
+            return std::unexpected(Error::InitializationFailed);
+
+        const auto newBuffer = driver.createBuffer(
+            BufferUsageBits::CopySource,
+            static_cast<uint32_t>(newCapacity),
+            1
+        );
+        if (!newBuffer)
+            return std::unexpected(newBuffer.error());
+
+        // Copies recorded from the old buffer may still run until the current frame has completed
+        if (buffer)
+            frames[frameIndex].retiredBuffers.push_back(buffer);
+
+        buffer = newBuffer.value();
+        data = driver.mapBuffer(buffer);
+        capacity = newCapacity;
+        head = 0;
+        used = 0;
+        for (auto& frame : frames)
+            frame.size = 0;
+
+        return {};
+    }
+
+    void StagingRing::destroyBuffer(
+        Buffer* stagingBuffer
+    ) const {
+        driver.unmapBuffer(stagingBuffer);
+        driver.destroyBuffer(stagingBuffer);
+    }
+
+    uint64_t StagingRing::getCapacity() const noexcept {
+        return capacity;
+    }
+
+    uint64_t StagingRing::getUsedSize() const noexcept {
+        return used;
+    }
+}
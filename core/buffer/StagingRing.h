@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <vector>
+
+namespace Vixen {
+    class Buffer;
+    class RenderingDeviceDriver;
+    enum class Error;
+
+    /**
+     * Space in a staging ring, which the caller writes its data into through the mapped pointer before recording a
+     * copy from the buffer at the offset, such as with commandCopyBuffer or commandCopyBufferToImage.
+     */
+    struct StagingAllocation {
+        Buffer* buffer;
+
+        uint64_t offset;
+
+        uint64_t size;
+
+        std::byte* data;
+    };
+
+    /**
+     * A single persistently mapped buffer that uploads of the CPU to the GPU sub-allocate their staging space from,
+     * instead of creating a buffer per upload. Space is handed out in a ring and reclaimed once the frame it was
+     * allocated in has completed. When a frame needs more space than is free, the ring grows into a buffer twice the
+     * size, and the old one is destroyed once every frame that may still copy from it has completed.
+     */
+    class StagingRing final {
+    public:
+        static constexpr uint64_t DefaultCapacity = 4 * 1024 * 1024;
+
+        /**
+         * The alignment of allocations when none is given, which satisfies the offset requirements of copies to
+         * images of every format.
+         */
+        static constexpr uint64_t DefaultAlignment = 16;
+
+    private:
+        struct FrameSpace {
+            /**
+             * The bytes allocated during the frame, including the padding before them.
+             */
+            uint64_t size;
+
+            /**
+             * Buffers the ring grew out of during the frame.
+             */
+            std::vector<Buffer*> retiredBuffers;
+        };
+
+        RenderingDeviceDriver& driver;
+
+        uint64_t initialCapacity;
+
+        Buffer* buffer = nullptr;
+
+        std::byte* data = nullptr;
+
+        uint64_t capacity = 0;
+
+        uint64_t head = 0;
+
+        uint64_t used = 0;
+
+        uint32_t frameIndex = 0;
+
+        std::vector<FrameSpace> frames;
+
+        auto grow(
+            uint64_t size
+        ) -> std::expected<void, Error>;
+
+        void destroyBuffer(
+            Buffer* stagingBuffer
+        ) const;
+
+    public:
+        /**
+         * @param framesInFlight The number of frames the GPU may be working on at once. Space allocated during a
+         * frame is reclaimed when the frame is next begun.
+         * @param initialCapacity The size of the buffer created on the first allocation.
+         */
+        StagingRing(
+            RenderingDeviceDriver& driver,
+            uint32_t framesInFlight,
+            uint64_t initialCapacity = DefaultCapacity
+        );
+
+        StagingRing(const StagingRing& other) = delete;
+
+        StagingRing(StagingRing&& other) noexcept = delete;
+
+        StagingRing& operator=(const StagingRing& other) = delete;
+
+        StagingRing& operator=(StagingRing&& other) noexcept = delete;
+
+        /**
+         * Destroys the buffers of the ring, which the GPU must no longer be copying from.
+         */
+        ~StagingRing();
+
+        /**
+         * Reclaims the space allocated the last time the frame was in use. Must be called once per frame, after
+         * waiting for the frame that is about to be reused, and only when a new frame begins. Flushing the commands
+         * of a frame halfway must not call it, since copies from space allocated earlier in the frame may still be
+         * recorded.
+         */
+        void beginFrame(
+            uint32_t frameIndex
+        );
+
+        /**
+         * Reclaims all space and destroys the buffers the ring grew out of, so the GPU must be idle.
+         */
+        void setFramesInFlight(
+            uint32_t count
+        );
+
+        /**
+         * Allocates space valid until the current frame has completed on the GPU, growing the ring if not enough is
+         * free.
+         * @param alignment The alignment of the offset, such as the size of a texel for copies to an image. Fails if
+         * it is zero.
+         */
+        auto allocate(
+            uint64_t size,
+            uint64_t alignment = DefaultAlignment
+        ) -> std::expected<StagingAllocation, Error>;
+
+        [[nodiscard]] uint64_t getCapacity() const noexcept;
+
+        /**
+         * The bytes allocated during frames the GPU may not have completed yet.
+         */
+        [[nodiscard]] uint64_t getUsedSize() const noexcept;
+    };
+}
@@ -0,0 +1,128 @@
+#include "UniformAllocator.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Buffer.h"
+#include "MemoryAlignment.h"
+#include "RenderingDeviceDriver.h"
+#include "error/Error.h"
+
+namespace Vixen {
+    UniformAllocator::UniformAllocator(
+        RenderingDeviceDriver& driver,
+        const uint32_t framesInFlight,
+        const uint64_t alignment,
+        const uint64_t maxRange,
+        const uint64_t blockSize
+    ) : driver(driver),
+        alignment(std::max<uint64_t>(alignment, 1)),
+        maxRange(maxRange),
+        blockSize(blockSize) {
+        setFramesInFlight(framesInFlight);
+    }
+
+    UniformAllocator::~UniformAllocator() {
+        for (auto& frame : frames)
+            destroyBlocks(frame);
+    }
+
+    void UniformAllocator::beginFrame(
+        const uint32_t frameIndex
+    ) {
+        this->frameIndex = frameIndex;
+
+        auto& frame = frames[frameIndex];
+        if (frame.blocks.size() > 1) {
+            uint64_t size = 0;
+            for (const auto& block : frame.blocks)
+                size += block.capacity;
+
+            destroyBlocks(frame);
+            frame.blockSize = std::min<uint64_t>(size, std::numeric_limits<uint32_t>::max());
+        }
+        frame.offset = 0;
+    }
+
+    void UniformAllocator::setFramesInFlight(
+        const uint32_t count
+    ) {
+        for (auto& frame : frames)
+            destroyBlocks(frame);
+
+        frames.clear();
+        frames.resize(
+            count,
+            {
+                .blocks = {},
+                .offset = 0,
+                .blockSize = blockSize
+            }
+        );
+        frameIndex = 0;
+    }
+
+    auto UniformAllocator::allocate(
+        const uint64_t size
+    ) -> std::expected<UniformAllocation, Error> {
+        if (size > maxRange)
+            return std::unexpected(Error::InitializationFailed);
+
+        auto& frame = frames[frameIndex];
+        uint64_t offset = alignUp(frame.offset, alignment);
+        if (frame.blocks.empty() || offset + size > frame.blocks.back().capacity) {
+            const uint64_t capacity = frame.blocks.empty()
+                                          ? std::max(frame.blockSize, size)
+                                          : std::max(blockSize, size);
+            if (capacity > std::numeric_limits<uint32_t>::max())
+                return std::unexpected(Error::InitializationFailed);
+
+            const auto buffer = driver.createBuffer(BufferUsageBits::Uniform, static_cast<uint32_t>(capacity), 1);
+            if (!buffer)
+                return std::unexpected(buffer.error());
+
+            frame.blocks.push_back({
+                .buffer = buffer.value(),
+                .data = driver.mapBuffer(buffer.value()),
+                .capacity = capacity
+            });
+            offset = 0;
+        }
+
+        const auto& block = frame.blocks.back();
+        frame.offset = offset + size;
+
+        return UniformAllocation{
+            .buffer = block.buffer,
+            .offset = offset,
+            .size = size,
+            .data = block.data + offset
+        };
+    }
+
+    void UniformAllocator::destroyBlocks(
+        FrameBlocks& frame
+    ) const {
+        for (const auto& block : frame.blocks) {
+            driver.unmapBuffer(block.buffer);
+            driver.destroyBuffer(block.buffer);
+        }
+        frame.blocks.clear();
+    }
+
+    uint64_t UniformAllocator::getAlignment() const noexcept {
+        return alignment;
+    }
+
+    uint64_t UniformAllocator::getUsedSize() const noexcept {
+        const auto& frame = frames[frameIndex];
+        if (frame.blocks.empty())
+            return 0;
+
+        uint64_t size = frame.offset;
+        for (std::size_t i = 0; i + 1 < frame.blocks.size(); i++)
+            size += frame.blocks[i].capacity;
+
+        return size;
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <type_traits>
+#include <vector>
+
+namespace Vixen {
+    class Buffer;
+    class RenderingDeviceDriver;
+    enum class Error;
+
+    /**
+     * A slice of a uniform buffer, which the caller writes its constants into through the mapped pointer and binds
+     * by passing the offset as the dynamic offset of the buffer.
+     */
+    struct UniformAllocation {
+        Buffer* buffer;
+
+        uint64_t offset;
+
+        uint64_t size;
+
+        std::byte* data;
+    };
+
+    /**
+     * Hands out slices of large persistently mapped uniform buffers for constants that only live for a frame, such as
+     * those of a single draw, instead of creating a uniform buffer for each. Slices are allocated linearly from the
+     * buffers of the current frame, which are rewound when the frame is next begun. A frame that outgrows its buffer
+     * continues in a new one, and starts the next time with a single buffer large enough for all of them.
+     */
+    class UniformAllocator final {
+    public:
+        static constexpr uint64_t DefaultBlockSize = 1024 * 1024;
+
+    private:
+        struct Block {
+            Buffer* buffer;
+
+            std::byte* data;
+
+            uint64_t capacity;
+        };
+
+        struct FrameBlocks {
+            std::vector<Block> blocks;
+
+            /**
+             * The end of the last slice in the last block.
+             */
+            uint64_t offset;
+
+            /**
+             * The size of the block created first during the frame.
+             */
+            uint64_t blockSize;
+        };
+
+        RenderingDeviceDriver& driver;
+
+        uint64_t alignment;
+
+        uint64_t maxRange;
+
+        uint64_t blockSize;
+
+        uint32_t frameIndex = 0;
+
+        std::vector<FrameBlocks> frames;
+
+        void destroyBlocks(
+            FrameBlocks& frame
+        ) const;
+
+    public:
+        /**
+         * @param framesInFlight The number of frames the GPU may be working on at once. Slices allocated during a
+         * frame are reused when the frame is next begun.
+         * @param alignment The alignment uniform buffers must be bound at, the device's uniformBufferOffsetAlignment.
+         * @param maxRange The largest slice that can be allocated, the device's maxUniformBufferRange.
+         */
+        UniformAllocator(
+            RenderingDeviceDriver& driver,
+            uint32_t framesInFlight,
+            uint64_t alignment,
+            uint64_t maxRange,
+            uint64_t blockSize = DefaultBlockSize
+        );
+
+        UniformAllocator(const UniformAllocator& other) = delete;
+
+        UniformAllocator(UniformAllocator&& other) noexcept = delete;
+
+        UniformAllocator& operator=(const UniformAllocator& other) = delete;
+
+        UniformAllocator& operator=(UniformAllocator&& other) noexcept = delete;
+
+        /**
+         * Destroys the buffers of every frame, which the GPU must no longer be reading from.
+         */
+        ~UniformAllocator();
+
+        /**
+         * Rewinds the buffers of the frame, merging them into one if there were several. Must be called once per
+         * frame, after waiting for the frame that is about to be reused, and only when a new frame begins. Flushing
+         * the commands of a frame halfway must not call it, since slices handed out earlier in the frame may still
+         * be bound.
+         */
+        void beginFrame(
+            uint32_t frameIndex
+        );
+
+        /**
+         * Destroys the buffers of every frame, so the GPU must be idle.
+         */
+        void setFramesInFlight(
+            uint32_t count
+        );
+
+        /**
+         * Allocates a slice valid until the current frame has completed on the GPU, at an offset aligned for binding.
+         * Fails if the size exceeds the largest range that can be bound.
+         */
+        auto allocate(
+            uint64_t size
+        ) -> std::expected<UniformAllocation, Error>;
+
+        /**
+         * Allocates a slice holding a copy of the constants.
+         */
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        auto write(
+            const T& constants
+        ) -> std::expected<UniformAllocation, Error> {
+            auto allocation = allocate(sizeof(T));
+            if (allocation)
+                std::memcpy(allocation->data, &constants, sizeof(T));
+
+            return allocation;
+        }
+
+        [[nodiscard]] uint64_t getAlignment() const noexcept;
+
+        /**
+         * The bytes allocated during the current frame, including the padding between slices.
+         */
+        [[nodiscard]] uint64_t getUsedSize() const noexcept;
+    };
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace Vixen {
+    struct Event {
+        virtual ~Event() = default;
+    };
+}
@@ -0,0 +1,99 @@
+#include "AliasingPlanner.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "MemoryAlignment.h"
+
+namespace Vixen {
+    namespace {
+        constexpr bool overlaps(const AliasingRequest& a, const AliasingRequest& b) {
+            return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse;
+        }
+    }
+
+    AliasingPlan planAliasing(const std::span<const AliasingRequest> requests) {
+        AliasingPlan plan{};
+        plan.placements.resize(requests.size());
+
+        std::vector<uint32_t> order(requests.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(
+            order,
+            [&requests](const uint32_t a, const uint32_t b) {
+                if (requests[a].requirements.size != requests[b].requirements.size)
+                    return requests[a].requirements.size > requests[b].requirements.size;
+
+                return a < b;
+            }
+        );
+
+        std::vector<std::vector<uint32_t>> heapContents;
+        std::vector<std::pair<uint64_t, uint64_t>> occupied;
+        for (const auto index : order) {
+            const auto& request = requests[index];
+            const auto size = request.requirements.size;
+            const auto alignment = std::max<uint64_t>(request.requirements.alignment, 1);
+
+            plan.naiveSize += size;
+
+            const auto heapIt = std::ranges::find_if(
+                plan.heaps,
+                [&request](const AliasingHeap& heap) {
+                    return heap.type == request.type &&
+                           heap.requirements.memoryTypeBits == request.requirements.memoryTypeBits;
+                }
+            );
+
+            const auto heapIndex = static_cast<uint32_t>(std::distance(plan.heaps.begin(), heapIt));
+            if (heapIt == plan.heaps.end()) {
+                plan.heaps.push_back({
+                    .type = request.type,
+                    .requirements = {
+                        .size = 0,
+                        .alignment = 1,
+                        .memoryTypeBits = request.requirements.memoryTypeBits
+                    }
+                });
+                heapContents.emplace_back();
+            }
+
+            occupied.clear();
+            for (const auto placed : heapContents[heapIndex]) {
+                const auto& other = requests[placed];
+                if (!overlaps(request, other))
+                    continue;
+
+                const auto offset = plan.placements[placed].offset;
+                occupied.emplace_back(offset, offset + other.requirements.size);
+            }
+            std::ranges::sort(occupied);
+
+            uint64_t offset = 0;
+            for (const auto& [begin, end] : occupied) {
+                offset = alignUp(offset, alignment);
+                if (offset + size <= begin)
+                    break;
+
+                offset = std::max(offset, end);
+            }
+            offset = alignUp(offset, alignment);
+
+            auto& heap = plan.heaps[heapIndex].requirements;
+            heap.size = std::max(heap.size, offset + size);
+            heap.alignment = std::max(heap.alignment, alignment);
+
+            plan.placements[index] = {
+                .heap = heapIndex,
+                .offset = offset
+            };
+            heapContents[heapIndex].push_back(index);
+        }
+
+        for (const auto& heap : plan.heaps)
+            plan.aliasedSize += heap.requirements.size;
+
+        return plan;
+    }
+}
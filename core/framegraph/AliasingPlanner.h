@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "BarrierBatch.h"
+#include "MemoryRequirements.h"
+#include "Resource.h"
+
+namespace Vixen {
+    /**
+     * A transient resource to place into shared memory, in use from the pass at position firstUse up to and including
+     * the pass at position lastUse of the execution order.
+     */
+    struct AliasingRequest {
+        uint32_t resource;
+
+        ResourceType type;
+
+        uint32_t firstUse;
+
+        uint32_t lastUse;
+
+        MemoryRequirements requirements;
+    };
+
+    /**
+     * One memory allocation shared by transient resources of the same type and memory type bits. Buffers and images
+     * never share a heap, so buffer-image granularity never has to be respected between neighbours.
+     */
+    struct AliasingHeap {
+        ResourceType type;
+
+        MemoryRequirements requirements;
+    };
+
+    struct AliasingPlacement {
+        uint32_t heap;
+
+        uint64_t offset;
+    };
+
+    struct AliasingPlan {
+        std::vector<AliasingHeap> heaps;
+
+        /**
+         * The heap and offset of every request, in the order the requests were given.
+         */
+        std::vector<AliasingPlacement> placements;
+
+        /**
+         * The memory the requests would need if each had its own allocation.
+         */
+        uint64_t naiveSize = 0;
+
+        /**
+         * The memory of all heaps together, which is the peak transient memory of the graph.
+         */
+        uint64_t aliasedSize = 0;
+    };
+
+    /**
+     * The shared memory of a graph's transient resources. It only depends on the structure of the graph, so graphs of
+     * the same structure share one layout.
+     */
+    struct AliasingLayout {
+        std::vector<AliasingRequest> requests;
+
+        AliasingPlan plan;
+
+        /**
+         * Per position in the execution order, the dependencies on earlier resources whose memory is reused by a
+         * resource first used at that position.
+         */
+        std::vector<BarrierBatch> barriers;
+    };
+
+    /**
+     * Places the requests into as few heaps as their memory types allow, largest first at the lowest offset not
+     * occupied by a request whose lifetime overlaps. Requests with disjoint lifetimes may share memory.
+     */
+    AliasingPlan planAliasing(std::span<const AliasingRequest> requests);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace Vixen {
+    struct CommandBuffer;
+
+    /**
+     * The command buffers a frame graph scheduled across the graphics and async compute queues is recorded into.
+     * The async compute command buffer must be submitted to the async compute queue, and the graphics command buffers
+     * to the graphics queue in order, with the second waiting for the async compute submission to complete.
+     */
+    struct AsyncComputeCommandBuffers {
+        /**
+         * Receives the graphics passes that do not depend on any async compute pass.
+         */
+        CommandBuffer* graphics;
+
+        CommandBuffer* asyncCompute;
+
+        /**
+         * Receives the remaining graphics passes, including those using resources produced on the async compute
+         * queue, along with the barriers that move imported resources into their final state.
+         */
+        CommandBuffer* graphicsAfterAsyncCompute;
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "BarrierAccessFlags.h"
+#include "MemoryBarrier.h"
+#include "PipelineStageFlags.h"
+#include "image/ImageLayout.h"
+#include "image/ImageSubresourceRange.h"
+
+namespace Vixen {
+    /**
+     * An image barrier that refers to a frame graph resource by index, resolved to a physical image when recorded.
+     */
+    struct ImageTransition {
+        uint32_t resource;
+        BarrierAccessFlags sourceAccess;
+        BarrierAccessFlags destinationAccess;
+        ImageLayout oldLayout;
+        ImageLayout newLayout;
+        ImageSubresourceRange subresources;
+        uint32_t sourceQueueFamily;
+        uint32_t destinationQueueFamily;
+    };
+
+    /**
+     * A buffer barrier that refers to a frame graph resource by index, resolved to a physical buffer when recorded.
+     */
+    struct BufferTransition {
+        uint32_t resource;
+        BarrierAccessFlags sourceAccess;
+        BarrierAccessFlags destinationAccess;
+        uint64_t offset;
+        uint64_t size;
+        uint32_t sourceQueueFamily;
+        uint32_t destinationQueueFamily;
+    };
+
+    /**
+     * All barriers required at one pass boundary, recorded as a single pipeline barrier.
+     */
+    struct BarrierBatch {
+        PipelineStageFlags sourceStages{};
+        PipelineStageFlags destinationStages{};
+        std::vector<MemoryBarrier> memoryBarriers;
+        std::vector<BufferTransition> bufferBarriers;
+        std::vector<ImageTransition> imageBarriers;
+
+        [[nodiscard]] bool empty() const noexcept {
+            return memoryBarriers.empty() && bufferBarriers.empty() && imageBarriers.empty();
+        }
+    };
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "BarrierBatch.h"
+#include "FrameGraphCompileOptions.h"
+#include "LoadAction.h"
+#include "StoreAction.h"
+
+namespace Vixen {
+    /**
+     * The span of the execution order in which a resource is in use, along with the accesses at either end that
+     * memory shared with other resources has to be synchronized against.
+     */
+    struct ResourceInterval {
+        uint32_t firstUse = std::numeric_limits<uint32_t>::max();
+
+        uint32_t lastUse = 0;
+
+        PipelineStageFlags firstStages{};
+
+        BarrierAccessFlags firstAccess{};
+
+        PipelineStageFlags lastStages{};
+
+        BarrierAccessFlags lastWriteAccess{};
+
+        /**
+         * True when a pass on the async compute queue uses the resource, which keeps it out of shared heaps.
+         */
+        bool asyncCompute = false;
+
+        [[nodiscard]] bool isUsed() const noexcept {
+            return firstUse <= lastUse;
+        }
+    };
+
+    /**
+     * A dependency between two passes with unrelated passes between them, signaled with an event after the producing
+     * pass and waited on before the consuming pass, so the GPU keeps working on the passes in between.
+     */
+    struct SplitBarrier {
+        uint32_t signalPosition;
+
+        uint32_t waitPosition;
+
+        BarrierBatch batch;
+    };
+
+    /**
+     * The load and store actions an attachment is recorded with.
+     */
+    struct AttachmentActions {
+        LoadAction loadAction;
+
+        StoreAction storeAction;
+    };
+
+    struct CompiledFrameGraph {
+        /**
+         * Indices of the render passes that survived culling, in the order they are recorded. Every pass appears
+         * after all passes it depends on.
+         */
+        std::vector<uint32_t> executionOrder;
+
+        /**
+         * Per render pass, the passes that must be recorded before it. This covers read-after-write, write-after-read
+         * and write-after-write hazards between passes that survived culling.
+         */
+        std::vector<std::vector<uint32_t>> dependencies;
+
+        /**
+         * Per render pass, true when none of the pass's outputs reach an imported or persistent resource or a pass
+         * with side effects.
+         */
+        std::vector<bool> culled;
+
+        /**
+         * Per position in the execution order, the barriers recorded immediately before that pass.
+         */
+        std::vector<BarrierBatch> passBarriers;
+
+        /**
+         * Per position in the execution order, true when the pass is recorded into the render pass begun by the pass
+         * before it, because it loads the same attachments that pass rendered to. The render pass keeps the load
+         * actions of its first pass and the store actions of its last.
+         */
+        std::vector<bool> continuesRendering;
+
+        /**
+         * Dependencies that are split into an event signaled after the pass at one position and waited on before the
+         * pass at another, instead of being part of the pass barriers.
+         */
+        std::vector<SplitBarrier> splitBarriers;
+
+        /**
+         * Per position in the execution order, the indices of the split barriers signaled after that pass.
+         */
+        std::vector<std::vector<uint32_t>> splitSignals;
+
+        /**
+         * Per position in the execution order, the indices of the split barriers waited on before that pass, which
+         * are waited on together.
+         */
+        std::vector<std::vector<uint32_t>> splitWaits;
+
+        /**
+         * Per render pass, the actions of its color attachments followed by those of its depth/stencil attachment.
+         * These are the actions the pass declared, except that stores whose contents no later pass reads are dropped,
+         * and transient attachments that are loaded before anything wrote them are not loaded.
+         */
+        std::vector<std::vector<AttachmentActions>> attachmentActions;
+
+        /**
+         * Per resource, true for transient images that are only ever used as attachments whose contents never leave
+         * the render pass, which are created in lazily allocated memory.
+         */
+        std::vector<bool> lazilyAllocated;
+
+        /**
+         * Barriers recorded after the last pass, moving every imported resource into its final state.
+         */
+        BarrierBatch finalBarriers;
+
+        /**
+         * Per resource, the positions in the execution order of its first and last use.
+         */
+        std::vector<ResourceInterval> resourceIntervals;
+
+        FrameGraphCompileOptions options;
+
+        /**
+         * The positions [asyncComputeBegin, asyncComputeEnd) of the execution order run on the async compute queue.
+         * Passes before them depend on no async compute pass, and passes after them run once the async compute work
+         * has finished.
+         */
+        uint32_t asyncComputeBegin = 0;
+
+        uint32_t asyncComputeEnd = 0;
+
+        /**
+         * Barriers recorded after the last async compute pass, releasing the resources graphics passes use afterwards
+         * to the graphics queue. The matching acquires are part of the pass barriers.
+         */
+        BarrierBatch asyncComputeReleaseBarriers;
+
+        [[nodiscard]] bool hasAsyncCompute() const noexcept {
+            return asyncComputeBegin != asyncComputeEnd;
+        }
+    };
+}
@@ -1,19 +1,2621 @@
 #include "FrameGraph.h"
 
 #include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <queue>
 #include <stdexcept>
 #include <utility>
 
+#include "AttachmentInfo.h"
+#include "FrameGraphCache.h"
+#include "FrameGraphProfiler.h"
+#include "FrameGraphResourcePool.h"
+#include "ParallelPassRecorder.h"
+#include "QueueFamilyFlags.h"
+#include "RenderPassContext.h"
+#include "RenderingDeviceDriver.h"
 #include "buffer/Buffer.h"
+#include "command/QueryPool.h"
+#include "error/CantCreateError.h"
 #include "image/Image.h"
 
 namespace Vixen {
-    FrameGraph::FrameGraph(std::vector<ResourceNode>&& resources, std::vector<RenderPass>&& renderPasses)
+    namespace {
+        constexpr uint32_t NoPass = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * The most split barriers signaled after, or waited on before, a single pass. Dependencies past it are folded
+         * into the pass barriers of the waiting pass, so a pass fed by many others does not juggle as many events.
+         */
+        constexpr std::size_t MaxSplitBarriersPerPosition = 16;
+
+        constexpr BarrierAccessFlags WriteAccess = BarrierAccessBits::ShaderWrite |
+            BarrierAccessBits::ColorAttachmentWrite |
+            BarrierAccessBits::DepthStencilAttachmentWrite |
+            BarrierAccessBits::CopyWrite |
+            BarrierAccessBits::HostWrite |
+            BarrierAccessBits::MemoryWrite |
+            BarrierAccessBits::ResolveWrite |
+            BarrierAccessBits::StorageClear;
+
+        /**
+         * The synchronization state of one resource while walking the execution order. The last write, or layout
+         * transition, is made visible to a growing set of stages and accesses, while reads since that write are
+         * accumulated so the next write can wait for them.
+         */
+        struct TrackedState {
+            ImageLayout layout = ImageLayout::Undefined;
+
+            PipelineStageFlags writeStages{};
+            BarrierAccessFlags writeAccess{};
+
+            PipelineStageFlags visibleStages{};
+            BarrierAccessFlags visibleAccess{};
+
+            PipelineStageFlags readStages{};
+
+            /**
+             * The positions in the execution order of the last write and of the last read since it, if any.
+             */
+            uint32_t writePosition = NoPass;
+            uint32_t readPosition = NoPass;
+        };
+
+        enum class TransitionKind {
+            None,
+            Execution,
+            Memory
+        };
+
+        struct Transition {
+            TransitionKind kind = TransitionKind::None;
+            PipelineStageFlags sourceStages{};
+            BarrierAccessFlags sourceAccess{};
+            ImageLayout oldLayout = ImageLayout::Undefined;
+
+            /**
+             * The position of the last pass whose accesses the transition waits for, or NoPass when they all happened
+             * before the graph.
+             */
+            uint32_t sourcePosition = NoPass;
+
+            bool operator==(const Transition& other) const = default;
+        };
+
+        /**
+         * What one subresource needs before it is used: the transition of its state, or its acquisition from the async
+         * compute queue, which releases it with the stages and accesses of its previous state.
+         */
+        struct SubresourceTransition {
+            Transition transition;
+
+            bool acquired = false;
+            PipelineStageFlags releaseStages{};
+            BarrierAccessFlags releaseAccess{};
+
+            bool operator==(const SubresourceTransition& other) const = default;
+        };
+
+        uint32_t latest(const uint32_t position, const uint32_t other) {
+            if (position == NoPass)
+                return other;
+
+            return other == NoPass ? position : std::max(position, other);
+        }
+
+        template <typename Bit>
+        constexpr bool covers(const Flags<Bit> flags, const Flags<Bit> subset) {
+            return (flags & subset) == subset;
+        }
+
+        uint64_t getSplitKey(const uint32_t signalPosition, const uint32_t waitPosition) {
+            return static_cast<uint64_t>(signalPosition) << 32 | waitPosition;
+        }
+
+        void appendBatch(BarrierBatch& batch, const BarrierBatch& other) {
+            batch.sourceStages |= other.sourceStages;
+            batch.destinationStages |= other.destinationStages;
+            batch.memoryBarriers.insert(
+                batch.memoryBarriers.end(),
+                other.memoryBarriers.begin(),
+                other.memoryBarriers.end()
+            );
+            batch.bufferBarriers.insert(
+                batch.bufferBarriers.end(),
+                other.bufferBarriers.begin(),
+                other.bufferBarriers.end()
+            );
+            batch.imageBarriers.insert(
+                batch.imageBarriers.end(),
+                other.imageBarriers.begin(),
+                other.imageBarriers.end()
+            );
+        }
+
+        Transition transition(
+            TrackedState& state,
+            const PipelineStageFlags stages,
+            const BarrierAccessFlags access,
+            const ImageLayout layout,
+            const bool writes,
+            const uint32_t position
+        ) {
+            Transition result{
+                .kind = TransitionKind::None,
+                .sourceStages = {},
+                .sourceAccess = {},
+                .oldLayout = state.layout,
+                .sourcePosition = NoPass
+            };
+
+            if (layout != state.layout || writes) {
+                const auto sourceStages = state.writeStages | state.readStages;
+
+                if (layout != state.layout || !state.writeAccess.empty()) {
+                    result.kind = TransitionKind::Memory;
+                    result.sourceStages = sourceStages;
+                    result.sourceAccess = state.writeAccess;
+                } else if (!sourceStages.empty()) {
+                    result.kind = TransitionKind::Execution;
+                    result.sourceStages = sourceStages;
+                }
+                result.sourcePosition = latest(state.writePosition, state.readPosition);
+
+                state = {
+                    .layout = layout,
+                    .writeStages = stages,
+                    .writeAccess = writes ? access & WriteAccess : BarrierAccessFlags{},
+                    .visibleStages = stages,
+                    .visibleAccess = access,
+                    .readStages = {},
+                    .writePosition = position,
+                    .readPosition = NoPass
+                };
+
+                return result;
+            }
+
+            if (!state.writeStages.empty() &&
+                !(covers(state.visibleStages, stages) && covers(state.visibleAccess, access))) {
+                result.kind = TransitionKind::Memory;
+                result.sourceStages = state.writeStages;
+                result.sourceAccess = state.writeAccess;
+                result.sourcePosition = state.writePosition;
+
+                state.visibleStages |= stages;
+                state.visibleAccess |= access;
+            }
+
+            state.readStages |= stages;
+            state.readPosition = position;
+
+            return result;
+        }
+
+        TrackedState getInitialState(const ResourceNode& resource) {
+            if (!resource.initialState)
+                return {};
+
+            PipelineStageFlags stages{};
+            BarrierAccessFlags access{};
+            ImageLayout layout = ImageLayout::Undefined;
+            if (const auto* imageState = std::get_if<ImageState>(&*resource.initialState)) {
+                stages = imageState->stages;
+                access = imageState->access;
+                layout = imageState->layout;
+            } else {
+                const auto& bufferState = std::get<BufferState>(*resource.initialState);
+                stages = bufferState.stages;
+                access = bufferState.access;
+            }
+
+            const auto writeAccess = access & WriteAccess;
+
+            return {
+                .layout = layout,
+                .writeStages = writeAccess.empty() ? PipelineStageFlags{} : stages,
+                .writeAccess = writeAccess,
+                .visibleStages = {},
+                .visibleAccess = {},
+                .readStages = writeAccess.empty() ? stages : PipelineStageFlags{},
+                .writePosition = NoPass,
+                .readPosition = NoPass
+            };
+        }
+
+        bool isReadOnly(const ImageUsageBits usage) {
+            switch (usage) {
+                    using enum ImageUsageBits;
+
+                case Sampling:
+                case InputAttachment:
+                case CpuRead:
+                case CopySource:
+                case TransientAttachment:
+                    return true;
+
+                case ColorAttachment:
+                case DepthStencilAttachment:
+                case Storage:
+                case StorageAtomic:
+                case Update:
+                case CopyDestination:
+                    return false;
+            }
+
+            std::unreachable();
+        }
+
+        bool isReadOnly(const BufferUsageBits usage) {
+            switch (usage) {
+                    using enum BufferUsageBits;
+
+                case CopySource:
+                case Uniform:
+                case Vertex:
+                case Index:
+                case Indirect:
+                    return true;
+
+                case CopyDestination:
+                case Texel:
+                case Storage:
+                    return false;
+            }
+
+            std::unreachable();
+        }
+
+        std::pair<BarrierAccessFlags, ImageLayout> getImageAccess(
+            const ImageUsageBits usage,
+            const ResourceAccess resourceAccess
+        ) {
+            const bool reads = resourceAccess != ResourceAccess::Write;
+            const bool writes = resourceAccess != ResourceAccess::Read;
+
+            BarrierAccessFlags access{};
+            switch (usage) {
+                    using enum ImageUsageBits;
+
+                case Sampling:
+                    return {BarrierAccessBits::ShaderRead, ImageLayout::ShaderReadOnlyOptimal};
+
+                case InputAttachment:
+                    return {BarrierAccessBits::InputAttachmentRead, ImageLayout::ShaderReadOnlyOptimal};
+
+                case ColorAttachment:
+                    if (reads)
+                        access |= BarrierAccessBits::ColorAttachmentRead;
+                    if (writes)
+                        access |= BarrierAccessBits::ColorAttachmentWrite;
+                    return {access, ImageLayout::ColorAttachmentOptimal};
+
+                case DepthStencilAttachment:
+                    if (reads)
+                        access |= BarrierAccessBits::DepthStencilAttachmentRead;
+                    if (writes)
+                        access |= BarrierAccessBits::DepthStencilAttachmentWrite;
+                    return {
+                        access,
+                        writes ? ImageLayout::DepthStencilAttachmentOptimal : ImageLayout::DepthStencilReadOnlyOptimal
+                    };
+
+                case Storage:
+                case StorageAtomic:
+                    if (reads)
+                        access |= BarrierAccessBits::ShaderRead;
+                    if (writes)
+                        access |= BarrierAccessBits::ShaderWrite;
+                    return {access, ImageLayout::General};
+
+                case CpuRead:
+                    return {BarrierAccessBits::HostRead, ImageLayout::General};
+
+                case CopySource:
+                    return {BarrierAccessBits::CopyRead, ImageLayout::CopySourceOptimal};
+
+                case Update:
+                case CopyDestination:
+                    return {BarrierAccessBits::CopyWrite, ImageLayout::CopyDestinationOptimal};
+
+                case TransientAttachment:
+                    break;
+            }
+
+            throw std::logic_error{"Transient attachment is not a frame graph image usage"};
+        }
+
+        BarrierAccessFlags getBufferAccess(
+            const BufferUsageBits usage,
+            const ResourceAccess resourceAccess
+        ) {
+            const bool reads = resourceAccess != ResourceAccess::Write;
+            const bool writes = resourceAccess != ResourceAccess::Read;
+
+            BarrierAccessFlags access{};
+            switch (usage) {
+                    using enum BufferUsageBits;
+
+                case CopySource:
+                    return BarrierAccessBits::CopyRead;
+
+                case CopyDestination:
+                    return BarrierAccessBits::CopyWrite;
+
+                case Uniform:
+                    return BarrierAccessBits::UniformRead;
+
+                case Vertex:
+                    return BarrierAccessBits::VertexAttributeRead;
+
+                case Index:
+                    return BarrierAccessBits::IndexRead;
+
+                case Indirect:
+                    return BarrierAccessBits::IndirectCommandsRead;
+
+                case Texel:
+                case Storage:
+                    if (reads)
+                        access |= BarrierAccessBits::ShaderRead;
+                    if (writes)
+                        access |= BarrierAccessBits::ShaderWrite;
+                    return access;
+            }
+
+            std::unreachable();
+        }
+
+        ImageSubresourceRange getFullSubresourceRange(const ImageFormat& format) {
+            return {
+                .aspect = getImageAspects(format.format),
+                .baseMipmap = 0,
+                .mipmapCount = format.mipmapCount,
+                .baseLayer = 0,
+                .layerCount = format.layerCount
+            };
+        }
+
+        /**
+         * How the state of each resource is split into separately tracked subresources: one per mipmap and layer of
+         * an image, and one per range of bytes between the bounds of the usages of a buffer.
+         */
+        struct SubresourceLayout {
+            /**
+             * Per resource, the index of its first subresource, followed by the total count.
+             */
+            std::vector<uint32_t> offsets;
+
+            /**
+             * Per buffer, the sorted offsets at which its usages begin and end, along with its start and end. Empty for
+             * images.
+             */
+            std::vector<std::vector<uint64_t>> bounds;
+
+            [[nodiscard]] uint32_t getCount() const {
+                return offsets.back();
+            }
+
+            /**
+             * Calls the function with every subresource the usage covers, in order, which for an image is layer by
+             * layer.
+             */
+            template <typename Function>
+            void forEach(
+                const ResourceUsage& usage,
+                const ResourceNode& resource,
+                const uint32_t index,
+                Function&& function
+            ) const {
+                if (const auto* bufferUsage = std::get_if<BufferResourceUsage>(&usage)) {
+                    const auto& bufferBounds = bounds[index];
+                    const auto first = std::ranges::lower_bound(bufferBounds, bufferUsage->offset);
+                    const auto last = std::ranges::lower_bound(bufferBounds, bufferUsage->offset + bufferUsage->size);
+                    for (auto bound = first; bound != last; ++bound)
+                        function(offsets[index] + static_cast<uint32_t>(bound - bufferBounds.begin()));
+
+                    return;
+                }
+
+                const auto mipmapCount = std::get<ImageResourceDescription>(resource.description).format.mipmapCount;
+                const auto& subresources = std::get<ImageResourceUsage>(usage).subresources;
+                const auto endLayer = subresources.baseLayer + subresources.layerCount;
+                const auto endMipmap = subresources.baseMipmap + subresources.mipmapCount;
+                for (uint32_t layer = subresources.baseLayer; layer < endLayer; ++layer)
+                    for (uint32_t mipmap = subresources.baseMipmap; mipmap < endMipmap; ++mipmap)
+                        function(offsets[index] + layer * mipmapCount + mipmap);
+            }
+        };
+
+        SubresourceLayout getSubresourceLayout(
+            const std::span<const ResourceNode> resources,
+            const std::span<const RenderPass> renderPasses
+        ) {
+            SubresourceLayout layout{
+                .offsets = {},
+                .bounds = std::vector<std::vector<uint64_t>>(resources.size())
+            };
+
+            for (uint32_t index = 0; index < resources.size(); ++index)
+                if (const auto* format = std::get_if<BufferFormat>(&resources[index].description))
+                    layout.bounds[index] = {0, format->getSize()};
+
+            for (const auto& pass : renderPasses)
+                for (const auto& usage : pass.getResourceUsages())
+                    if (const auto* bufferUsage = std::get_if<BufferResourceUsage>(&usage)) {
+                        const auto index = bufferUsage->input.isValid()
+                                               ? bufferUsage->input.id.index
+                                               : bufferUsage->output.id.index;
+                        layout.bounds[index].push_back(bufferUsage->offset);
+                        layout.bounds[index].push_back(bufferUsage->offset + bufferUsage->size);
+                    }
+
+            layout.offsets.reserve(resources.size() + 1);
+            layout.offsets.push_back(0);
+            for (uint32_t index = 0; index < resources.size(); ++index) {
+                if (const auto* description = std::get_if<ImageResourceDescription>(&resources[index].description)) {
+                    const auto& format = description->format;
+                    layout.offsets.push_back(layout.offsets.back() + format.mipmapCount * format.layerCount);
+                    continue;
+                }
+
+                auto& bounds = layout.bounds[index];
+                std::ranges::sort(bounds);
+                bounds.erase(std::ranges::unique(bounds).begin(), bounds.end());
+                layout.offsets.push_back(layout.offsets.back() + static_cast<uint32_t>(bounds.size() - 1));
+            }
+
+            return layout;
+        }
+
+        /**
+         * Merges the transitions of consecutive ranges of the buffer, starting at the given bound, into the largest
+         * ranges with equal transitions, and calls the function with the offset and size of each.
+         */
+        template <typename Function>
+        void forEachTransitionRange(
+            const std::span<const uint64_t> bounds,
+            const std::size_t first,
+            const std::span<const SubresourceTransition> transitions,
+            Function&& function
+        ) {
+            for (std::size_t begin = 0, end = 0; begin < transitions.size(); begin = end) {
+                end = begin + 1;
+                while (end < transitions.size() && transitions[end] == transitions[begin])
+                    ++end;
+
+                function(bounds[first + begin], bounds[first + end] - bounds[first + begin], transitions[begin]);
+            }
+        }
+
+        /**
+         * Merges the transitions of the subresources in the range, given layer by layer, into rectangles of mipmaps
+         * and layers with equal transitions, and calls the function with each. A range whose subresources are all in
+         * the same state therefore gets a single barrier.
+         */
+        template <typename Function>
+        void forEachTransitionRange(
+            const ImageSubresourceRange& subresources,
+            const std::span<const SubresourceTransition> transitions,
+            Function&& function
+        ) {
+            std::vector<std::pair<ImageSubresourceRange, SubresourceTransition>> ranges;
+            for (uint32_t layer = 0; layer < subresources.layerCount; ++layer) {
+                const auto row = transitions.subspan(layer * subresources.mipmapCount, subresources.mipmapCount);
+
+                for (uint32_t begin = 0, end = 0; begin < row.size(); begin = end) {
+                    end = begin + 1;
+                    while (end < row.size() && row[end] == row[begin])
+                        ++end;
+
+                    const auto baseMipmap = subresources.baseMipmap + begin;
+                    const auto mipmapCount = end - begin;
+                    const auto baseLayer = subresources.baseLayer + layer;
+
+                    const auto above = std::ranges::find_if(ranges, [&](const auto& range) {
+                        return range.first.baseMipmap == baseMipmap &&
+                               range.first.mipmapCount == mipmapCount &&
+                               range.first.baseLayer + range.first.layerCount == baseLayer &&
+                               range.second == row[begin];
+                    });
+
+                    if (above != ranges.end()) {
+                        ++above->first.layerCount;
+                        continue;
+                    }
+
+                    ranges.emplace_back(
+                        ImageSubresourceRange{
+                            .aspect = subresources.aspect,
+                            .baseMipmap = baseMipmap,
+                            .mipmapCount = mipmapCount,
+                            .baseLayer = baseLayer,
+                            .layerCount = 1
+                        },
+                        row[begin]
+                    );
+                }
+            }
+
+            for (const auto& [range, transition] : ranges)
+                function(range, transition);
+        }
+
+        void addTransition(
+            BarrierBatch& batch,
+            const Transition& transition,
+            const PipelineStageFlags destinationStages
+        ) {
+            batch.sourceStages |= transition.sourceStages;
+            batch.destinationStages |= destinationStages;
+
+            if (transition.kind == TransitionKind::Execution && batch.memoryBarriers.empty())
+                batch.memoryBarriers.push_back({});
+        }
+
+        /**
+         * Host-readable images and mapped buffers need host-visible memory and transient attachments lazily allocated
+         * memory, neither of which the shared device-local heaps provide.
+         */
+        bool isAliasable(const ResourceNode& resource) {
+            if (resource.lifetime != ResourceLifetime::Transient)
+                return false;
+
+            if (const auto* description = std::get_if<ImageResourceDescription>(&resource.description))
+                return !description->format.usage.contains(ImageUsageBits::CpuRead) &&
+                       !description->format.usage.contains(ImageUsageBits::TransientAttachment);
+
+            const auto& format = std::get<BufferFormat>(resource.description);
+
+            return !format.usage.contains(BufferUsageBits::Uniform) &&
+                   !format.usage.contains(BufferUsageBits::CopySource);
+        }
+
+        AttachmentInfo getAttachmentInfo(
+            const RenderAttachment& attachment,
+            const AttachmentActions& actions,
+            Image* image,
+            const ImageLayout layout
+        ) {
+            return {
+                .image = image,
+                .layout = layout,
+                .loadAction = actions.loadAction,
+                .storeAction = actions.storeAction,
+                .resolveImage = nullptr,
+                .clearValue = attachment.clearValue
+            };
+        }
+
+        /**
+         * The store action of an attachment whose contents nothing reads afterwards.
+         */
+        StoreAction dropStore(const StoreAction storeAction) {
+            switch (storeAction) {
+                case StoreAction::Store:
+                    return StoreAction::DontCare;
+
+                case StoreAction::StoreAndResolve:
+                    return StoreAction::Resolve;
+
+                case StoreAction::Resolve:
+                case StoreAction::DontCare:
+                    return storeAction;
+            }
+
+            std::unreachable();
+        }
+
+        /**
+         * Whether the usage is that of a color or depth/stencil attachment, which passes only declare through their
+         * attachments.
+         */
+        bool isAttachmentUsage(const ResourceUsage& usage) {
+            const auto* imageUsage = std::get_if<ImageResourceUsage>(&usage);
+
+            return imageUsage &&
+                   (imageUsage->usage == ImageUsageBits::ColorAttachment ||
+                    imageUsage->usage == ImageUsageBits::DepthStencilAttachment);
+        }
+
+        std::pair<ResourceId, ResourceId> getUsageIds(const ResourceUsage& usage) {
+            return std::visit(
+                [](const auto& typedUsage) {
+                    return std::pair{typedUsage.input.id, typedUsage.output.id};
+                },
+                usage
+            );
+        }
+
+        void addUnique(std::vector<uint32_t>& passes, const uint32_t pass) {
+            if (std::ranges::find(passes, pass) == passes.end())
+                passes.push_back(pass);
+        }
+
+        bool isRendering(const RenderPass& pass) {
+            return pass.getType() == RenderPassType::Graphics &&
+                   (!pass.getColorAttachments().empty() || pass.getDepthStencilAttachment().has_value());
+        }
+
+        /**
+         * The resource indices of the pass's color attachments followed by its depth/stencil attachment, or an invalid
+         * index when it has none.
+         */
+        std::vector<uint32_t> getAttachmentIndices(const RenderPass& pass) {
+            std::vector<uint32_t> indices;
+            for (const auto& attachment : pass.getColorAttachments())
+                indices.push_back(attachment.handle.id.index);
+
+            const auto& depthStencil = pass.getDepthStencilAttachment();
+            indices.push_back(depthStencil ? depthStencil->handle.id.index : ResourceId::Invalid);
+
+            return indices;
+        }
+
+        glm::vec3 getLabelColor(const RenderPass& pass) {
+            return pass.getType() == RenderPassType::Graphics
+                       ? glm::vec3{0.3f, 0.6f, 1.0f}
+                       : glm::vec3{1.0f, 0.6f, 0.2f};
+        }
+
+        bool loadsAttachments(const RenderPass& pass) {
+            const auto loads = [](const RenderAttachment& attachment) {
+                return attachment.loadAction == LoadAction::Load;
+            };
+
+            const auto& depthStencil = pass.getDepthStencilAttachment();
+            return std::ranges::all_of(pass.getColorAttachments(), loads) && (!depthStencil || loads(*depthStencil));
+        }
+
+        template <typename... Values>
+        void appendStructure(std::pmr::vector<uint64_t>& structure, const Values... values) {
+            (structure.push_back(static_cast<uint64_t>(values)), ...);
+        }
+
+        void appendStructure(std::pmr::vector<uint64_t>& structure, const std::optional<ResourceState>& state) {
+            if (!state) {
+                appendStructure(structure, 0);
+                return;
+            }
+
+            if (const auto* image = std::get_if<ImageState>(&*state))
+                appendStructure(structure, 1, image->stages.value(), image->access.value(), image->layout);
+            else {
+                const auto& buffer = std::get<BufferState>(*state);
+                appendStructure(structure, 2, buffer.stages.value(), buffer.access.value());
+            }
+        }
+
+        void appendStructure(std::pmr::vector<uint64_t>& structure, const RenderAttachment& attachment) {
+            appendStructure(
+                structure,
+                attachment.handle.id.index,
+                attachment.handle.id.version,
+                attachment.loadAction,
+                attachment.storeAction
+            );
+        }
+
+        uint64_t hashStructure(const std::span<const uint64_t> structure) {
+            // FNV-1a over the bytes of every token.
+            uint64_t hash = 14695981039346656037ull;
+            for (auto token : structure) {
+                for (int byte = 0; byte < 8; ++byte) {
+                    hash = (hash ^ (token & 0xFF)) * 1099511628211ull;
+                    token >>= 8;
+                }
+            }
+
+            return hash;
+        }
+    }
+
+    FrameGraph::FrameGraph(std::pmr::vector<ResourceNode>&& resources, std::pmr::vector<RenderPass>&& renderPasses)
         : resources(std::move(resources)),
-          renderPasses(std::move(renderPasses)) {}
+          renderPasses(std::move(renderPasses)),
+          physicalResources(this->resources.get_allocator()),
+          transientHeaps(this->resources.get_allocator()),
+          events(this->resources.get_allocator()),
+          recordTimes(this->resources.get_allocator()) {}
+
+    FrameGraph::FrameGraph(FrameGraph&& other) noexcept
+        : resources(std::move(other.resources)),
+          renderPasses(std::move(other.renderPasses)),
+          compiled(std::move(other.compiled)),
+          cache(std::exchange(other.cache, nullptr)),
+          structureHash(other.structureHash),
+          resourcePool(std::exchange(other.resourcePool, nullptr)),
+          ownedResourcePool(std::move(other.ownedResourcePool)),
+          physicalResources(std::move(other.physicalResources)),
+          aliasingLayout(std::move(other.aliasingLayout)),
+          transientHeaps(std::move(other.transientHeaps)),
+          events(std::move(other.events)),
+          recordTimes(std::move(other.recordTimes)),
+          profiler(std::exchange(other.profiler, nullptr)),
+          firstQuery(std::exchange(other.firstQuery, std::nullopt)) {}
+
+    FrameGraph& FrameGraph::operator=(FrameGraph&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        releaseResources();
+
+        resources = std::move(other.resources);
+        renderPasses = std::move(other.renderPasses);
+        compiled = std::move(other.compiled);
+        cache = std::exchange(other.cache, nullptr);
+        structureHash = other.structureHash;
+        resourcePool = std::exchange(other.resourcePool, nullptr);
+        ownedResourcePool = std::move(other.ownedResourcePool);
+        physicalResources = std::move(other.physicalResources);
+        aliasingLayout = std::move(other.aliasingLayout);
+        transientHeaps = std::move(other.transientHeaps);
+        events = std::move(other.events);
+        recordTimes = std::move(other.recordTimes);
+        profiler = std::exchange(other.profiler, nullptr);
+        firstQuery = std::exchange(other.firstQuery, std::nullopt);
+
+        return *this;
+    }
+
+    void FrameGraph::mergeRenderPasses(CompiledFrameGraph& plan) const {
+        const auto positionCount = static_cast<uint32_t>(plan.executionOrder.size());
+        plan.continuesRendering.assign(positionCount, false);
+
+        constexpr auto unused = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> lastPositions(resources.size(), unused);
+        uint32_t spanStart = 0;
+
+        std::vector<std::vector<uint32_t>> splitsWaitingAt(positionCount);
+        for (uint32_t split = 0; split < plan.splitBarriers.size(); ++split)
+            splitsWaitingAt[plan.splitBarriers[split].waitPosition].push_back(split);
+
+        for (uint32_t position = 0; position < positionCount; ++position) {
+            const auto& pass = renderPasses[plan.executionOrder[position]];
+            const auto attachments = getAttachmentIndices(pass);
+            const auto isAttachment = [&attachments](const uint32_t index) {
+                return std::ranges::find(attachments, index) != attachments.end();
+            };
+
+            std::vector<uint32_t> usedResources;
+            for (const auto& usage : pass.getResourceUsages()) {
+                const auto [input, output] = getUsageIds(usage);
+                usedResources.push_back(input.isValid() ? input.index : output.index);
+            }
+
+            auto& batch = plan.passBarriers[position];
+
+            /*
+             * A pass continues the render pass of the pass before it when it renders to the same attachments and loads
+             * them, so their contents never leave tile memory. Accesses to the attachments themselves are ordered by
+             * rasterization order, but no other barrier can be recorded while rendering, so every other resource
+             * of the pass must not have been touched since the render pass began, which lets its barriers move ahead
+             * of it.
+             */
+            bool merge = position > 0 &&
+                         isRendering(pass) &&
+                         loadsAttachments(pass) &&
+                         getAttachmentIndices(renderPasses[plan.executionOrder[position - 1]]) == attachments;
+
+            merge = merge && std::ranges::none_of(batch.imageBarriers, [&](const ImageTransition& barrier) {
+                return barrier.sourceQueueFamily != QueueFamilyIgnored ||
+                       (isAttachment(barrier.resource) && barrier.oldLayout != barrier.newLayout);
+            });
+
+            merge = merge && std::ranges::none_of(batch.bufferBarriers, [](const BufferTransition& barrier) {
+                return barrier.sourceQueueFamily != QueueFamilyIgnored;
+            });
+
+            merge = merge && std::ranges::none_of(usedResources, [&](const uint32_t index) {
+                return !isAttachment(index) && lastPositions[index] != unused && lastPositions[index] >= spanStart;
+            });
+
+            if (merge) {
+                plan.continuesRendering[position] = true;
+
+                auto& spanBatch = plan.passBarriers[spanStart];
+                bool hoisted = false;
+                for (auto& barrier : batch.imageBarriers) {
+                    if (isAttachment(barrier.resource))
+                        continue;
+
+                    spanBatch.imageBarriers.push_back(barrier);
+                    hoisted = true;
+                }
+
+                for (auto& barrier : batch.bufferBarriers) {
+                    spanBatch.bufferBarriers.push_back(barrier);
+                    hoisted = true;
+                }
+
+                for (auto& barrier : batch.memoryBarriers) {
+                    spanBatch.memoryBarriers.push_back(barrier);
+                    hoisted = true;
+                }
+
+                if (hoisted) {
+                    spanBatch.sourceStages |= batch.sourceStages;
+                    spanBatch.destinationStages |= batch.destinationStages;
+                }
+
+                batch = {};
+
+                for (const auto split : splitsWaitingAt[position])
+                    plan.splitBarriers[split].waitPosition = spanStart;
+
+                // Memory shared with resources first used here is handed over before the render pass begins.
+                for (const auto index : usedResources) {
+                    auto& interval = plan.resourceIntervals[index];
+                    if (!isAttachment(index) && interval.firstUse == position)
+                        interval.firstUse = spanStart;
+                }
+            } else {
+                spanStart = position;
+            }
+
+            for (const auto index : usedResources)
+                lastPositions[index] = position;
+        }
+
+        // Events cannot be signaled while rendering, so they are signaled once the render pass has ended.
+        std::erase_if(
+            plan.splitBarriers,
+            [&plan, positionCount](SplitBarrier& split) {
+                while (split.signalPosition + 1 < positionCount && plan.continuesRendering[split.signalPosition + 1])
+                    ++split.signalPosition;
+
+                if (split.signalPosition + 1 < split.waitPosition)
+                    return false;
+
+                appendBatch(plan.passBarriers[split.waitPosition], split.batch);
+                return true;
+            }
+        );
+    }
+
+    void FrameGraph::indexSplitBarriers(CompiledFrameGraph& plan) {
+        const auto positionCount = plan.executionOrder.size();
+        plan.splitSignals.assign(positionCount, {});
+        plan.splitWaits.assign(positionCount, {});
+
+        /*
+         * Moving the halves out of render passes can leave several splits between the same two passes, which share an
+         * event. Past the limit of a position, dependencies are recorded as plain barriers before the waiting pass.
+         */
+        std::unordered_map<uint64_t, uint32_t> splitIndices;
+        std::vector<SplitBarrier> splits;
+        splits.reserve(plan.splitBarriers.size());
+        for (auto& split : plan.splitBarriers) {
+            const auto key = getSplitKey(split.signalPosition, split.waitPosition);
+            if (const auto index = splitIndices.find(key); index != splitIndices.end()) {
+                appendBatch(splits[index->second].batch, split.batch);
+                continue;
+            }
+
+            auto& signals = plan.splitSignals[split.signalPosition];
+            auto& waits = plan.splitWaits[split.waitPosition];
+            if (signals.size() >= MaxSplitBarriersPerPosition || waits.size() >= MaxSplitBarriersPerPosition) {
+                appendBatch(plan.passBarriers[split.waitPosition], split.batch);
+                continue;
+            }
+
+            const auto index = static_cast<uint32_t>(splits.size());
+            splitIndices.emplace(key, index);
+            signals.push_back(index);
+            waits.push_back(index);
+            splits.push_back(std::move(split));
+        }
+
+        plan.splitBarriers = std::move(splits);
+    }
+
+    void FrameGraph::inferAttachmentActions(CompiledFrameGraph& plan) const {
+        plan.attachmentActions.assign(renderPasses.size(), {});
+        for (uint32_t pass = 0; pass < renderPasses.size(); ++pass) {
+            auto& actions = plan.attachmentActions[pass];
+            for (const auto& attachment : renderPasses[pass].getColorAttachments())
+                actions.push_back({
+                    .loadAction = attachment.loadAction,
+                    .storeAction = dropStore(attachment.storeAction)
+                });
+
+            if (const auto& attachment = renderPasses[pass].getDepthStencilAttachment())
+                actions.push_back({
+                    .loadAction = attachment->loadAction,
+                    .storeAction = dropStore(attachment->storeAction)
+                });
+        }
+
+        /*
+         * Every store starts out dropped. Walking the execution order, each subresource remembers the attachment whose
+         * store holds its contents, which is kept once a later pass reads them, or when they outlive the graph.
+         */
+        constexpr auto NoAttachment = std::numeric_limits<uint32_t>::max();
+        const auto subresourceLayout = getSubresourceLayout(resources, renderPasses);
+        std::vector<std::pair<uint32_t, uint32_t>> storedBy(subresourceLayout.getCount(), {NoPass, NoAttachment});
+        std::vector<bool> written(subresourceLayout.getCount(), false);
+
+        const auto keepStore = [&](const std::pair<uint32_t, uint32_t>& stored) {
+            const auto [pass, attachment] = stored;
+            if (pass == NoPass)
+                return;
+
+            const auto& renderPass = renderPasses[pass];
+            const auto& colorAttachments = renderPass.getColorAttachments();
+            const auto storeAction = attachment < colorAttachments.size()
+                                         ? colorAttachments[attachment].storeAction
+                                         : renderPass.getDepthStencilAttachment()->storeAction;
+
+            plan.attachmentActions[pass][attachment].storeAction = storeAction;
+        };
+
+        for (const auto pass : plan.executionOrder) {
+            const auto& renderPass = renderPasses[pass];
+            const auto attachments = getAttachmentIndices(renderPass);
+
+            for (const auto& usage : renderPass.getResourceUsages()) {
+                const auto [input, output] = getUsageIds(usage);
+                const auto index = input.isValid() ? input.index : output.index;
+                const auto& resource = resources[index];
+
+                auto attachment = NoAttachment;
+                if (output.isValid() && isAttachmentUsage(usage))
+                    attachment = static_cast<uint32_t>(std::ranges::find(attachments, index) - attachments.begin());
+
+                bool loaded = false;
+                subresourceLayout.forEach(usage, resource, index, [&](const uint32_t subresource) {
+                    if (input.isValid()) {
+                        keepStore(storedBy[subresource]);
+                        loaded = loaded || written[subresource];
+                    }
+
+                    if (output.isValid()) {
+                        storedBy[subresource] = {attachment == NoAttachment ? NoPass : pass, attachment};
+                        written[subresource] = true;
+                    }
+                });
+
+                auto& actions = plan.attachmentActions[pass];
+                if (attachment != NoAttachment &&
+                    !loaded &&
+                    resource.lifetime == ResourceLifetime::Transient &&
+                    actions[attachment].loadAction == LoadAction::Load)
+                    actions[attachment].loadAction = LoadAction::DontCare;
+            }
+        }
+
+        for (uint32_t index = 0; index < resources.size(); ++index) {
+            if (resources[index].lifetime == ResourceLifetime::Transient)
+                continue;
+
+            for (auto subresource = subresourceLayout.offsets[index];
+                 subresource < subresourceLayout.offsets[index + 1];
+                 ++subresource)
+                keepStore(storedBy[subresource]);
+        }
+
+        /*
+         * A transient image whose render passes neither load nor store it, and that is never used any other way, only
+         * ever lives in tile memory.
+         */
+        constexpr ImageUsageFlags attachmentUsage = ImageUsageBits::ColorAttachment |
+            ImageUsageBits::DepthStencilAttachment |
+            ImageUsageBits::TransientAttachment;
+
+        plan.lazilyAllocated.assign(resources.size(), false);
+        for (uint32_t index = 0; index < resources.size(); ++index) {
+            const auto& resource = resources[index];
+            const auto* description = std::get_if<ImageResourceDescription>(&resource.description);
+
+            plan.lazilyAllocated[index] = description &&
+                                          resource.lifetime == ResourceLifetime::Transient &&
+                                          covers(attachmentUsage, description->format.usage) &&
+                                          plan.resourceIntervals[index].isUsed() &&
+                                          !plan.resourceIntervals[index].asyncCompute;
+        }
+
+        const auto positionCount = plan.executionOrder.size();
+        for (std::size_t position = 0; position < positionCount; ++position) {
+            const auto pass = plan.executionOrder[position];
+            const auto& renderPass = renderPasses[pass];
+
+            for (const auto& usage : renderPass.getResourceUsages()) {
+                const auto [input, output] = getUsageIds(usage);
+                if (!isAttachmentUsage(usage))
+                    plan.lazilyAllocated[input.isValid() ? input.index : output.index] = false;
+            }
+
+            const bool beginsRendering = !plan.continuesRendering[position];
+            const bool endsRendering = position + 1 == positionCount || !plan.continuesRendering[position + 1];
+            const auto attachments = getAttachmentIndices(renderPass);
+            for (std::size_t attachment = 0; attachment < plan.attachmentActions[pass].size(); ++attachment) {
+                const auto& [loadAction, storeAction] = plan.attachmentActions[pass][attachment];
+
+                if ((beginsRendering && loadAction == LoadAction::Load) ||
+                    (endsRendering && (storeAction == StoreAction::Store ||
+                                       storeAction == StoreAction::StoreAndResolve)))
+                    plan.lazilyAllocated[attachments[attachment]] = false;
+            }
+        }
+    }
+
+    FrameGraph::~FrameGraph() {
+        releaseResources();
+    }
+
+    void FrameGraph::planBarriers(CompiledFrameGraph& plan) const {
+        // Resources are tracked per subresource, so their barriers only cover the parts that need them.
+        const auto subresourceLayout = getSubresourceLayout(resources, renderPasses);
+        const auto& subresourceOffsets = subresourceLayout.offsets;
+        std::vector<TrackedState> states;
+        states.reserve(subresourceLayout.getCount());
+        for (uint32_t index = 0; index < resources.size(); ++index)
+            states.insert(
+                states.end(),
+                subresourceOffsets[index + 1] - subresourceOffsets[index],
+                getInitialState(resources[index])
+            );
+
+        plan.passBarriers.assign(plan.executionOrder.size(), {});
+        plan.asyncComputeReleaseBarriers = {};
+        plan.resourceIntervals.assign(resources.size(), {});
+
+        const auto recordUse = [&plan](
+            const uint32_t index,
+            const uint32_t position,
+            const PipelineStageFlags stages,
+            const BarrierAccessFlags access
+        ) {
+            auto& interval = plan.resourceIntervals[index];
+            if (!interval.isUsed()) {
+                interval.firstUse = position;
+                interval.firstStages = stages;
+                interval.firstAccess = access;
+            }
+
+            interval.lastUse = position;
+        };
+
+        const auto graphicsQueueFamily = plan.options.graphicsQueueFamily;
+        const auto asyncComputeQueueFamily = plan.options.asyncComputeQueueFamily.value_or(QueueFamilyIgnored);
+
+        /*
+         * Resources last used on the async compute queue are released by it after its last pass, and acquired by the
+         * first graphics pass that uses them afterwards.
+         */
+        std::vector<bool> ownedByAsyncCompute(subresourceLayout.getCount(), false);
+        const auto handOver = [&](const uint32_t index, const uint32_t subresource, const uint32_t position) {
+            if (position >= plan.asyncComputeBegin && position < plan.asyncComputeEnd) {
+                ownedByAsyncCompute[subresource] = true;
+                plan.resourceIntervals[index].asyncCompute = true;
+                return false;
+            }
+
+            const bool owned = ownedByAsyncCompute[subresource];
+            ownedByAsyncCompute[subresource] = false;
+            return owned;
+        };
+
+        /*
+         * A dependency on a pass with unrelated passes between it and the pass that waits is split, so the GPU keeps
+         * working on those passes instead of draining at the boundary. Both halves must be recorded for the same
+         * queue, in the same part of the graph.
+         */
+        const auto getSegment = [&plan](const uint32_t position) {
+            if (position < plan.asyncComputeBegin)
+                return 0;
+
+            return position < plan.asyncComputeEnd ? 1 : 2;
+        };
+
+        plan.splitBarriers.clear();
+        std::unordered_map<uint64_t, std::size_t> splitIndices;
+        const auto getBatch = [&](const Transition& result, const uint32_t position) -> BarrierBatch& {
+            const auto source = result.sourcePosition;
+            if (source == NoPass || source + 1 >= position || getSegment(source) != getSegment(position))
+                return plan.passBarriers[position];
+
+            const auto [split, inserted] = splitIndices.try_emplace(
+                getSplitKey(source, position),
+                plan.splitBarriers.size()
+            );
+            if (!inserted)
+                return plan.splitBarriers[split->second].batch;
+
+            return plan.splitBarriers.emplace_back(
+                SplitBarrier{
+                    .signalPosition = source,
+                    .waitPosition = position,
+                    .batch = {}
+                }
+            ).batch;
+        };
+
+        // Transitions the subresources the usage covers, collecting what each needs into the transitions.
+        std::vector<SubresourceTransition> transitions;
+        const auto trackUsage = [&](
+            const ResourceUsage& usage,
+            const uint32_t index,
+            const PipelineStageFlags stages,
+            const BarrierAccessFlags access,
+            const ImageLayout layout,
+            const bool writes,
+            const uint32_t position
+        ) {
+            transitions.clear();
+            subresourceLayout.forEach(usage, resources[index], index, [&](const uint32_t subresource) {
+                const auto previous = states[subresource];
+                const auto result = transition(
+                    states[subresource],
+                    stages,
+                    access,
+                    layout,
+                    writes,
+                    position
+                );
+
+                if (!handOver(index, subresource, position)) {
+                    transitions.push_back({.transition = result});
+                    return;
+                }
+
+                transitions.push_back({
+                    .transition = {.oldLayout = previous.layout},
+                    .acquired = true,
+                    .releaseStages = previous.writeStages | previous.readStages,
+                    .releaseAccess = previous.writeAccess
+                });
+            });
+        };
+
+        for (uint32_t position = 0; position < plan.executionOrder.size(); ++position) {
+            const auto& pass = renderPasses[plan.executionOrder[position]];
+            auto& batch = plan.passBarriers[position];
+
+            for (const auto& usage : pass.getResourceUsages()) {
+                if (const auto* imageUsage = std::get_if<ImageResourceUsage>(&usage)) {
+                    const auto index = imageUsage->input.isValid()
+                                           ? imageUsage->input.id.index
+                                           : imageUsage->output.id.index;
+                    const auto& resource = resources[index];
+                    const auto& format = std::get<ImageResourceDescription>(resource.description).format;
+                    const bool writes = imageUsage->access != ResourceAccess::Read;
+
+                    if (!format.usage.contains(imageUsage->usage))
+                        throw std::logic_error{
+                            "Pass '" + std::string{pass.getName()} +
+                            "' uses frame graph image '" + std::string{resource.name} +
+                            "' with a usage it was not created with"
+                        };
+
+                    if (writes && isReadOnly(imageUsage->usage))
+                        throw std::logic_error{
+                            "Pass '" + std::string{pass.getName()} +
+                            "' writes frame graph image '" + std::string{resource.name} +
+                            "' through a read-only usage"
+                        };
+
+                    const auto [access, layout] = getImageAccess(imageUsage->usage, imageUsage->access);
+                    recordUse(index, position, imageUsage->stages, access);
+
+                    trackUsage(usage, index, imageUsage->stages, access, layout, writes, position);
+
+                    const ImageSubresourceRange subresources{
+                        .aspect = getImageAspects(format.format),
+                        .baseMipmap = imageUsage->subresources.baseMipmap,
+                        .mipmapCount = imageUsage->subresources.mipmapCount,
+                        .baseLayer = imageUsage->subresources.baseLayer,
+                        .layerCount = imageUsage->subresources.layerCount
+                    };
+
+                    forEachTransitionRange(
+                        subresources,
+                        transitions,
+                        [&](const ImageSubresourceRange& range, const SubresourceTransition& subresourceTransition) {
+                            const auto& result = subresourceTransition.transition;
+
+                            if (subresourceTransition.acquired) {
+                                auto& release = plan.asyncComputeReleaseBarriers;
+                                release.sourceStages |= subresourceTransition.releaseStages;
+                                release.imageBarriers.push_back({
+                                    .resource = index,
+                                    .sourceAccess = subresourceTransition.releaseAccess,
+                                    .destinationAccess = {},
+                                    .oldLayout = result.oldLayout,
+                                    .newLayout = layout,
+                                    .subresources = range,
+                                    .sourceQueueFamily = asyncComputeQueueFamily,
+                                    .destinationQueueFamily = graphicsQueueFamily
+                                });
+
+                                batch.destinationStages |= imageUsage->stages;
+                                batch.imageBarriers.push_back({
+                                    .resource = index,
+                                    .sourceAccess = {},
+                                    .destinationAccess = access,
+                                    .oldLayout = result.oldLayout,
+                                    .newLayout = layout,
+                                    .subresources = range,
+                                    .sourceQueueFamily = asyncComputeQueueFamily,
+                                    .destinationQueueFamily = graphicsQueueFamily
+                                });
+                                return;
+                            }
+
+                            if (result.kind == TransitionKind::None)
+                                return;
+
+                            auto& target = getBatch(result, position);
+                            addTransition(target, result, imageUsage->stages);
+                            if (result.kind == TransitionKind::Memory)
+                                target.imageBarriers.push_back({
+                                    .resource = index,
+                                    .sourceAccess = result.sourceAccess,
+                                    .destinationAccess = access,
+                                    .oldLayout = result.oldLayout,
+                                    .newLayout = layout,
+                                    .subresources = range,
+                                    .sourceQueueFamily = QueueFamilyIgnored,
+                                    .destinationQueueFamily = QueueFamilyIgnored
+                                });
+                        }
+                    );
+                } else {
+                    const auto& bufferUsage = std::get<BufferResourceUsage>(usage);
+                    const auto index = bufferUsage.input.isValid()
+                                           ? bufferUsage.input.id.index
+                                           : bufferUsage.output.id.index;
+                    const auto& resource = resources[index];
+                    const auto& format = std::get<BufferFormat>(resource.description);
+                    const bool writes = bufferUsage.access != ResourceAccess::Read;
+
+                    if (!format.usage.contains(bufferUsage.usage))
+                        throw std::logic_error{
+                            "Pass '" + std::string{pass.getName()} +
+                            "' uses frame graph buffer '" + std::string{resource.name} +
+                            "' with a usage it was not created with"
+                        };
+
+                    if (writes && isReadOnly(bufferUsage.usage))
+                        throw std::logic_error{
+                            "Pass '" + std::string{pass.getName()} +
+                            "' writes frame graph buffer '" + std::string{resource.name} +
+                            "' through a read-only usage"
+                        };
+
+                    const auto access = getBufferAccess(bufferUsage.usage, bufferUsage.access);
+                    recordUse(index, position, bufferUsage.stages, access);
+
+                    trackUsage(usage, index, bufferUsage.stages, access, ImageLayout::Undefined, writes, position);
+
+                    const auto& bounds = subresourceLayout.bounds[index];
+                    forEachTransitionRange(
+                        bounds,
+                        std::ranges::lower_bound(bounds, bufferUsage.offset) - bounds.begin(),
+                        transitions,
+                        [&](
+                            const uint64_t offset,
+                            const uint64_t size,
+                            const SubresourceTransition& subresourceTransition
+                        ) {
+                            const auto& result = subresourceTransition.transition;
+
+                            if (subresourceTransition.acquired) {
+                                auto& release = plan.asyncComputeReleaseBarriers;
+                                release.sourceStages |= subresourceTransition.releaseStages;
+                                release.bufferBarriers.push_back({
+                                    .resource = index,
+                                    .sourceAccess = subresourceTransition.releaseAccess,
+                                    .destinationAccess = {},
+                                    .offset = offset,
+                                    .size = size,
+                                    .sourceQueueFamily = asyncComputeQueueFamily,
+                                    .destinationQueueFamily = graphicsQueueFamily
+                                });
+
+                                batch.destinationStages |= bufferUsage.stages;
+                                batch.bufferBarriers.push_back({
+                                    .resource = index,
+                                    .sourceAccess = {},
+                                    .destinationAccess = access,
+                                    .offset = offset,
+                                    .size = size,
+                                    .sourceQueueFamily = asyncComputeQueueFamily,
+                                    .destinationQueueFamily = graphicsQueueFamily
+                                });
+                                return;
+                            }
+
+                            if (result.kind == TransitionKind::None)
+                                return;
+
+                            auto& target = getBatch(result, position);
+                            addTransition(target, result, bufferUsage.stages);
+                            if (result.kind == TransitionKind::Memory)
+                                target.bufferBarriers.push_back({
+                                    .resource = index,
+                                    .sourceAccess = result.sourceAccess,
+                                    .destinationAccess = access,
+                                    .offset = offset,
+                                    .size = size,
+                                    .sourceQueueFamily = QueueFamilyIgnored,
+                                    .destinationQueueFamily = QueueFamilyIgnored
+                                });
+                        }
+                    );
+                }
+            }
+        }
+
+        for (uint32_t index = 0; index < resources.size(); ++index) {
+            auto& interval = plan.resourceIntervals[index];
+            for (auto subresource = subresourceOffsets[index]; subresource < subresourceOffsets[index + 1];
+                 ++subresource) {
+                interval.lastStages |= states[subresource].writeStages | states[subresource].readStages;
+                interval.lastWriteAccess |= states[subresource].writeAccess;
+            }
+        }
+
+        plan.finalBarriers = {};
+        for (uint32_t index = 0; index < resources.size(); ++index) {
+            const auto& resource = resources[index];
+            if (!resource.finalState)
+                continue;
+
+            if (const auto* imageState = std::get_if<ImageState>(&*resource.finalState)) {
+                transitions.clear();
+                for (auto subresource = subresourceOffsets[index]; subresource < subresourceOffsets[index + 1];
+                     ++subresource)
+                    transitions.push_back({
+                        .transition = transition(
+                            states[subresource],
+                            imageState->stages,
+                            imageState->access,
+                            imageState->layout,
+                            !(imageState->access & WriteAccess).empty(),
+                            NoPass
+                        )
+                    });
+
+                forEachTransitionRange(
+                    getFullSubresourceRange(std::get<ImageResourceDescription>(resource.description).format),
+                    transitions,
+                    [&](const ImageSubresourceRange& range, const SubresourceTransition& subresourceTransition) {
+                        const auto& result = subresourceTransition.transition;
+                        if (result.kind == TransitionKind::None)
+                            return;
+
+                        addTransition(plan.finalBarriers, result, imageState->stages);
+                        if (result.kind == TransitionKind::Memory)
+                            plan.finalBarriers.imageBarriers.push_back({
+                                .resource = index,
+                                .sourceAccess = result.sourceAccess,
+                                .destinationAccess = imageState->access,
+                                .oldLayout = result.oldLayout,
+                                .newLayout = imageState->layout,
+                                .subresources = range,
+                                .sourceQueueFamily = QueueFamilyIgnored,
+                                .destinationQueueFamily = QueueFamilyIgnored
+                            });
+                    }
+                );
+            } else {
+                const auto& bufferState = std::get<BufferState>(*resource.finalState);
+                transitions.clear();
+                for (auto subresource = subresourceOffsets[index]; subresource < subresourceOffsets[index + 1];
+                     ++subresource)
+                    transitions.push_back({
+                        .transition = transition(
+                            states[subresource],
+                            bufferState.stages,
+                            bufferState.access,
+                            ImageLayout::Undefined,
+                            !(bufferState.access & WriteAccess).empty(),
+                            NoPass
+                        )
+                    });
+
+                forEachTransitionRange(
+                    subresourceLayout.bounds[index],
+                    0,
+                    transitions,
+                    [&](
+                        const uint64_t offset,
+                        const uint64_t size,
+                        const SubresourceTransition& subresourceTransition
+                    ) {
+                        const auto& result = subresourceTransition.transition;
+                        if (result.kind == TransitionKind::None)
+                            return;
+
+                        addTransition(plan.finalBarriers, result, bufferState.stages);
+                        if (result.kind == TransitionKind::Memory)
+                            plan.finalBarriers.bufferBarriers.push_back({
+                                .resource = index,
+                                .sourceAccess = result.sourceAccess,
+                                .destinationAccess = bufferState.access,
+                                .offset = offset,
+                                .size = size,
+                                .sourceQueueFamily = QueueFamilyIgnored,
+                                .destinationQueueFamily = QueueFamilyIgnored
+                            });
+                    }
+                );
+            }
+        }
+    }
+
+    bool FrameGraph::isShared(const uint32_t index) const {
+        const auto& interval = compiled->resourceIntervals[index];
+
+        // Shared heaps are synchronized by barriers on a single queue.
+        return interval.isUsed() &&
+               !interval.asyncCompute &&
+               !compiled->lazilyAllocated[index] &&
+               isAliasable(resources[index]);
+    }
+
+    std::shared_ptr<const AliasingLayout> FrameGraph::createAliasingLayout(RenderingDeviceDriver& driver) const {
+        const auto& intervals = compiled->resourceIntervals;
+
+        auto layout = std::make_shared<AliasingLayout>();
+        for (uint32_t index = 0; index < resources.size(); ++index) {
+            if (!isShared(index))
+                continue;
+
+            const auto& resource = resources[index];
+            const auto* description = std::get_if<ImageResourceDescription>(&resource.description);
+            const auto* format = std::get_if<BufferFormat>(&resource.description);
+
+            const auto requirements = description != nullptr
+                                          ? driver.getImageMemoryRequirements(description->format)
+                                          : driver.getBufferMemoryRequirements(
+                                              format->usage,
+                                              format->count,
+                                              format->stride
+                                          );
+            if (!requirements)
+                throw CantCreateError{
+                    "Failed to query memory requirements of frame graph resource '" + std::string{resource.name} + "'"
+                };
+
+            layout->requests.push_back({
+                .resource = index,
+                .type = resource.type,
+                .firstUse = intervals[index].firstUse,
+                .lastUse = intervals[index].lastUse,
+                .requirements = *requirements
+            });
+        }
+
+        layout->plan = planAliasing(layout->requests);
+        planAliasingBarriers(*layout);
+
+        return layout;
+    }
+
+    void FrameGraph::realizeResources(FrameGraphResourcePool& pool) {
+        resourcePool = &pool;
+        physicalResources.assign(resources.size(), std::monostate{});
+        recordTimes.assign(compiled->executionOrder.size(), {});
+        if (profiler != nullptr)
+            firstQuery = profiler->addGraph(*this);
+
+        try {
+            if (!aliasingLayout) {
+                aliasingLayout = createAliasingLayout(pool.getDriver());
+                if (cache != nullptr)
+                    cache->setAliasingLayout(structureHash, compiled.get(), aliasingLayout);
+            }
+
+            for (uint32_t index = 0; index < resources.size(); ++index) {
+                const auto& resource = resources[index];
+
+                if (resource.lifetime == ResourceLifetime::Imported) {
+                    physicalResources[index] = resource.importedResource;
+                    continue;
+                }
+
+                if (!compiled->resourceIntervals[index].isUsed() || isShared(index))
+                    continue;
+
+                if (const auto* description = std::get_if<ImageResourceDescription>(&resource.description)) {
+                    auto imageDescription = *description;
+                    if (compiled->lazilyAllocated[index])
+                        imageDescription.format.usage |= ImageUsageBits::TransientAttachment;
+
+                    const auto image = pool.acquireImage(imageDescription);
+                    if (!image)
+                        throw CantCreateError{
+                            "Failed to create frame graph image '" + std::string{resource.name} + "'"
+                        };
+
+                    physicalResources[index] = image.value();
+                } else {
+                    const auto buffer = pool.acquireBuffer(std::get<BufferFormat>(resource.description));
+                    if (!buffer)
+                        throw CantCreateError{
+                            "Failed to create frame graph buffer '" + std::string{resource.name} + "'"
+                        };
+
+                    physicalResources[index] = buffer.value();
+                }
+            }
+
+            events.reserve(compiled->splitBarriers.size());
+            for (std::size_t i = 0; i < compiled->splitBarriers.size(); ++i) {
+                const auto event = pool.acquireEvent();
+                if (!event)
+                    throw CantCreateError{"Failed to create frame graph event"};
+
+                events.push_back(event.value());
+            }
+
+            const auto& [requests, plan, barriers] = *aliasingLayout;
+
+            transientHeaps.reserve(plan.heaps.size());
+            for (const auto& heap : plan.heaps) {
+                const auto allocation = pool.acquireMemory(heap.requirements);
+                if (!allocation)
+                    throw CantCreateError{"Failed to allocate frame graph transient memory"};
+
+                transientHeaps.push_back(allocation.value());
+            }
+
+            for (std::size_t i = 0; i < requests.size(); ++i) {
+                const auto index = requests[i].resource;
+                const auto& resource = resources[index];
+                const auto& placement = plan.placements[i];
+
+                if (const auto* description = std::get_if<ImageResourceDescription>(&resource.description)) {
+                    const auto image = pool.acquireAliasedImage(
+                        *description,
+                        transientHeaps[placement.heap],
+                        placement.offset
+                    );
+                    if (!image)
+                        throw CantCreateError{
+                            "Failed to create frame graph image '" + std::string{resource.name} + "'"
+                        };
+
+                    physicalResources[index] = image.value();
+                } else {
+                    const auto& format = std::get<BufferFormat>(resource.description);
+                    const auto buffer = pool.acquireAliasedBuffer(
+                        format,
+                        transientHeaps[placement.heap],
+                        placement.offset
+                    );
+                    if (!buffer)
+                        throw CantCreateError{
+                            "Failed to create frame graph buffer '" + std::string{resource.name} + "'"
+                        };
+
+                    physicalResources[index] = buffer.value();
+                }
+            }
+        } catch (...) {
+            releaseResources();
+            throw;
+        }
+    }
+
+    void FrameGraph::planAliasingBarriers(AliasingLayout& layout) const {
+        const auto& intervals = compiled->resourceIntervals;
+        const auto& requests = layout.requests;
+        const auto& placements = layout.plan.placements;
+
+        layout.barriers.assign(compiled->executionOrder.size(), {});
+
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            const auto& request = requests[i];
+            const auto& placement = placements[i];
+            const auto& interval = intervals[request.resource];
+
+            for (std::size_t j = 0; j < requests.size(); ++j) {
+                const auto& previous = requests[j];
+                const auto& previousPlacement = placements[j];
+
+                if (previousPlacement.heap != placement.heap || previous.lastUse >= request.firstUse)
+                    continue;
+
+                if (previousPlacement.offset >= placement.offset + request.requirements.size ||
+                    placement.offset >= previousPlacement.offset + previous.requirements.size)
+                    continue;
+
+                const auto& previousInterval = intervals[previous.resource];
+                auto& batch = layout.barriers[request.firstUse];
+                batch.sourceStages |= previousInterval.lastStages;
+                batch.destinationStages |= interval.firstStages;
+
+                if (batch.memoryBarriers.empty())
+                    batch.memoryBarriers.push_back({});
+
+                batch.memoryBarriers.front().sourceAccess |= previousInterval.lastWriteAccess;
+                batch.memoryBarriers.front().targetAccess |= interval.firstAccess;
+            }
+        }
+    }
+
+    void FrameGraph::releaseResources() {
+        if (resourcePool == nullptr)
+            return;
+
+        const std::size_t requestCount = aliasingLayout ? aliasingLayout->requests.size() : 0;
+        for (std::size_t i = 0; i < requestCount && !physicalResources.empty(); ++i) {
+            const auto index = aliasingLayout->requests[i].resource;
+            const auto& placement = aliasingLayout->plan.placements[i];
+            auto& physicalResource = physicalResources[index];
+
+            if (auto* const* image = std::get_if<Image*>(&physicalResource))
+                resourcePool->releaseAliasedImage(
+                    std::get<ImageResourceDescription>(resources[index].description),
+                    transientHeaps[placement.heap],
+                    placement.offset,
+                    *image
+                );
+            else if (auto* const* buffer = std::get_if<Buffer*>(&physicalResource))
+                resourcePool->releaseAliasedBuffer(
+                    std::get<BufferFormat>(resources[index].description),
+                    transientHeaps[placement.heap],
+                    placement.offset,
+                    *buffer
+                );
+
+            physicalResource = std::monostate{};
+        }
+
+        for (uint32_t index = 0; index < physicalResources.size(); ++index) {
+            if (resources[index].lifetime == ResourceLifetime::Imported)
+                continue;
+
+            if (auto* const* image = std::get_if<Image*>(&physicalResources[index]))
+                resourcePool->releaseImage(std::get<ImageResourceDescription>(resources[index].description), *image);
+            else if (auto* const* buffer = std::get_if<Buffer*>(&physicalResources[index]))
+                resourcePool->releaseBuffer(std::get<BufferFormat>(resources[index].description), *buffer);
+        }
+
+        for (std::size_t heap = 0; heap < transientHeaps.size(); ++heap)
+            resourcePool->releaseMemory(aliasingLayout->plan.heaps[heap].requirements, transientHeaps[heap]);
+
+        for (auto* event : events)
+            resourcePool->releaseEvent(event);
+
+        physicalResources.clear();
+        transientHeaps.clear();
+        events.clear();
+        resourcePool = nullptr;
+        ownedResourcePool.reset();
+    }
+
+    auto FrameGraph::createRecordingScratch(const std::size_t count) const -> std::pmr::vector<RecordingScratch> {
+        const auto& plan = *compiled;
+
+        std::size_t memoryBarrierCount = 0;
+        std::size_t bufferBarrierCount = 0;
+        std::size_t imageBarrierCount = 0;
+        std::size_t eventWaitCount = 0;
+        std::size_t colorAttachmentCount = 0;
+        const auto fit = [&](const BarrierBatch& batch) {
+            memoryBarrierCount = std::max(memoryBarrierCount, batch.memoryBarriers.size());
+            bufferBarrierCount = std::max(bufferBarrierCount, batch.bufferBarriers.size());
+            imageBarrierCount = std::max(imageBarrierCount, batch.imageBarriers.size());
+        };
+
+        fit(plan.finalBarriers);
+        fit(plan.asyncComputeReleaseBarriers);
+        for (const auto& split : plan.splitBarriers)
+            fit(split.batch);
+
+        for (std::size_t position = 0; position < plan.executionOrder.size(); ++position) {
+            const auto& batch = plan.passBarriers[position];
+            fit(batch);
+            memoryBarrierCount = std::max(
+                memoryBarrierCount,
+                batch.memoryBarriers.size() + aliasingLayout->barriers[position].memoryBarriers.size()
+            );
+
+            // The splits waited on at a position are recorded together, so their barriers are stored side by side.
+            std::size_t waitBufferBarrierCount = 0;
+            std::size_t waitImageBarrierCount = 0;
+            for (const auto split : plan.splitWaits[position]) {
+                waitBufferBarrierCount += plan.splitBarriers[split].batch.bufferBarriers.size();
+                waitImageBarrierCount += plan.splitBarriers[split].batch.imageBarriers.size();
+            }
+            bufferBarrierCount = std::max(bufferBarrierCount, waitBufferBarrierCount);
+            imageBarrierCount = std::max(imageBarrierCount, waitImageBarrierCount);
+            eventWaitCount = std::max(eventWaitCount, plan.splitWaits[position].size());
+
+            colorAttachmentCount = std::max(
+                colorAttachmentCount,
+                renderPasses[plan.executionOrder[position]].getColorAttachments().size()
+            );
+        }
+
+        const auto allocator = resources.get_allocator();
+        std::pmr::vector<RecordingScratch> scratch(allocator);
+        scratch.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto& entry = scratch.emplace_back(
+                RecordingScratch{
+                    .memoryBarriers = std::pmr::vector<MemoryBarrier>(allocator),
+                    .bufferBarriers = std::pmr::vector<BufferBarrier>(allocator),
+                    .imageBarriers = std::pmr::vector<ImageBarrier>(allocator),
+                    .eventWaits = std::pmr::vector<EventWait>(allocator),
+                    .colorAttachments = std::pmr::vector<AttachmentInfo>(allocator)
+                }
+            );
+            entry.memoryBarriers.reserve(memoryBarrierCount);
+            entry.bufferBarriers.reserve(bufferBarrierCount);
+            entry.imageBarriers.reserve(imageBarrierCount);
+            entry.eventWaits.reserve(eventWaitCount);
+            entry.colorAttachments.reserve(colorAttachmentCount);
+        }
+
+        return scratch;
+    }
+
+    void FrameGraph::recordBarriers(
+        CommandBuffer* commandBuffer,
+        RecordingScratch& scratch,
+        const BarrierBatch& batch,
+        const BarrierBatch* aliasing
+    ) const {
+        if (aliasing != nullptr && aliasing->empty())
+            aliasing = nullptr;
+
+        if (batch.empty() && aliasing == nullptr)
+            return;
+
+        auto sourceStages = batch.sourceStages;
+        auto destinationStages = batch.destinationStages;
+        std::span<const MemoryBarrier> memoryBarriers = batch.memoryBarriers;
+        if (aliasing != nullptr) {
+            sourceStages |= aliasing->sourceStages;
+            destinationStages |= aliasing->destinationStages;
+            scratch.memoryBarriers.assign(batch.memoryBarriers.begin(), batch.memoryBarriers.end());
+            scratch.memoryBarriers.insert(
+                scratch.memoryBarriers.end(),
+                aliasing->memoryBarriers.begin(),
+                aliasing->memoryBarriers.end()
+            );
+            memoryBarriers = scratch.memoryBarriers;
+        }
+
+        scratch.bufferBarriers.clear();
+        scratch.imageBarriers.clear();
+        appendBufferBarriers(batch, scratch.bufferBarriers);
+        appendImageBarriers(batch, scratch.imageBarriers);
+
+        resourcePool->getDriver().commandPipelineBarrier(
+            commandBuffer,
+            sourceStages,
+            destinationStages,
+            memoryBarriers,
+            scratch.bufferBarriers,
+            scratch.imageBarriers
+        );
+    }
+
+    void FrameGraph::recordSplitSignal(
+        CommandBuffer* commandBuffer,
+        RecordingScratch& scratch,
+        const uint32_t split
+    ) const {
+        const auto& batch = compiled->splitBarriers[split].batch;
+        scratch.bufferBarriers.clear();
+        scratch.imageBarriers.clear();
+        appendBufferBarriers(batch, scratch.bufferBarriers);
+        appendImageBarriers(batch, scratch.imageBarriers);
+
+        resourcePool->getDriver().commandSetEvent(
+            commandBuffer,
+            events[split],
+            batch.sourceStages,
+            batch.destinationStages,
+            batch.memoryBarriers,
+            scratch.bufferBarriers,
+            scratch.imageBarriers
+        );
+    }
+
+    void FrameGraph::recordSplitWaits(
+        CommandBuffer* commandBuffer,
+        RecordingScratch& scratch,
+        const std::span<const uint32_t> splits
+    ) const {
+        if (splits.empty())
+            return;
+
+        scratch.bufferBarriers.clear();
+        scratch.imageBarriers.clear();
+        for (const auto split : splits) {
+            appendBufferBarriers(compiled->splitBarriers[split].batch, scratch.bufferBarriers);
+            appendImageBarriers(compiled->splitBarriers[split].batch, scratch.imageBarriers);
+        }
+
+        // The waits point into the converted barriers only once all of them are in place.
+        const std::span<const BufferBarrier> bufferBarriers = scratch.bufferBarriers;
+        const std::span<const ImageBarrier> imageBarriers = scratch.imageBarriers;
+        std::size_t bufferOffset = 0;
+        std::size_t imageOffset = 0;
+        scratch.eventWaits.clear();
+        for (const auto split : splits) {
+            const auto& batch = compiled->splitBarriers[split].batch;
+            scratch.eventWaits.push_back({
+                .event = events[split],
+                .sourceStages = batch.sourceStages,
+                .destinationStages = batch.destinationStages,
+                .memoryBarriers = batch.memoryBarriers,
+                .bufferBarriers = bufferBarriers.subspan(bufferOffset, batch.bufferBarriers.size()),
+                .imageBarriers = imageBarriers.subspan(imageOffset, batch.imageBarriers.size())
+            });
+            bufferOffset += batch.bufferBarriers.size();
+            imageOffset += batch.imageBarriers.size();
+        }
+
+        auto& driver = resourcePool->getDriver();
+        driver.commandWaitEvents(commandBuffer, scratch.eventWaits);
+
+        // Resetting once the waiting stages are done leaves the events unsignaled for the next graph that uses them.
+        for (const auto split : splits)
+            driver.commandResetEvent(
+                commandBuffer,
+                events[split],
+                compiled->splitBarriers[split].batch.destinationStages
+            );
+    }
+
+    void FrameGraph::appendBufferBarriers(
+        const BarrierBatch& batch,
+        std::pmr::vector<BufferBarrier>& bufferBarriers
+    ) const {
+        for (const auto& barrier : batch.bufferBarriers)
+            bufferBarriers.push_back({
+                .buffer = std::get<Buffer*>(physicalResources[barrier.resource]),
+                .sourceAccess = barrier.sourceAccess,
+                .destinationAccess = barrier.destinationAccess,
+                .offset = barrier.offset,
+                .size = barrier.size,
+                .sourceQueueFamily = barrier.sourceQueueFamily,
+                .destinationQueueFamily = barrier.destinationQueueFamily
+            });
+    }
+
+    void FrameGraph::appendImageBarriers(
+        const BarrierBatch& batch,
+        std::pmr::vector<ImageBarrier>& imageBarriers
+    ) const {
+        for (const auto& barrier : batch.imageBarriers)
+            imageBarriers.push_back({
+                .image = std::get<Image*>(physicalResources[barrier.resource]),
+                .sourceAccess = barrier.sourceAccess,
+                .destinationAccess = barrier.destinationAccess,
+                .oldLayout = barrier.oldLayout,
+                .newLayout = barrier.newLayout,
+                .subresources = barrier.subresources,
+                .sourceQueueFamily = barrier.sourceQueueFamily,
+                .destinationQueueFamily = barrier.destinationQueueFamily
+            });
+    }
+
+    void FrameGraph::orderPasses(CompiledFrameGraph& plan) const {
+        const auto passCount = static_cast<uint32_t>(renderPasses.size());
+        const auto reorder = plan.options.reorderPasses;
+
+        std::vector<std::vector<uint32_t>> dependents(passCount);
+        std::vector<std::vector<uint32_t>> attachments(passCount);
+        std::vector<uint32_t> pendingDependencies(passCount, 0);
+        uint32_t alivePassCount = 0;
+        for (uint32_t pass = 0; pass < passCount; ++pass) {
+            if (plan.culled[pass])
+                continue;
+
+            ++alivePassCount;
+            for (const auto dependency : plan.dependencies[pass])
+                dependents[dependency].push_back(pass);
+
+            pendingDependencies[pass] = static_cast<uint32_t>(plan.dependencies[pass].size());
+            if (reorder && isRendering(renderPasses[pass]))
+                attachments[pass] = getAttachmentIndices(renderPasses[pass]);
+        }
+
+        /*
+         * Passes are picked one at a time from those whose dependencies have all been recorded. Without reordering,
+         * the earliest declared one is picked, which reproduces declaration order. Otherwise a pass rendering to the
+         * same attachments as the previous one goes first, since the two can share a render pass or at least keep
+         * the attachments in their layouts. Such a pass writes the attachments after the previous one did, so it only
+         * ever becomes ready by recording the previous one. Next comes a pass of the same type as the previous one, so
+         * graphics and compute work stay in runs and async compute candidates end up together. Among those, the pass
+         * whose latest dependency was recorded the longest ago goes first, which moves consumers away from their
+         * producers and leaves the GPU other work to overlap with each barrier.
+         */
+        using ReadyPass = std::pair<uint32_t, uint32_t>;
+        using ReadyQueue = std::priority_queue<ReadyPass, std::vector<ReadyPass>, std::greater<>>;
+        std::array<ReadyQueue, 2> ready;
+        const auto getQueue = [&](const uint32_t pass) -> ReadyQueue& {
+            return reorder ? ready[static_cast<std::size_t>(renderPasses[pass].getType())] : ready[0];
+        };
+
+        std::vector<uint32_t> positions(passCount, 0);
+        std::vector<bool> recorded(passCount, false);
+        std::vector<uint32_t> readied;
+        const auto makeReady = [&](const uint32_t pass) {
+            uint32_t latestDependency = 0;
+            if (reorder)
+                for (const auto dependency : plan.dependencies[pass])
+                    latestDependency = std::max(latestDependency, positions[dependency] + 1);
+
+            getQueue(pass).emplace(latestDependency, pass);
+            readied.push_back(pass);
+        };
+
+        for (uint32_t pass = 0; pass < passCount; ++pass)
+            if (!plan.culled[pass] && pendingDependencies[pass] == 0)
+                makeReady(pass);
+
+        plan.executionOrder.clear();
+        plan.executionOrder.reserve(alivePassCount);
+        while (true) {
+            uint32_t pass = NoPass;
+            if (reorder && !plan.executionOrder.empty()) {
+                const auto& previous = attachments[plan.executionOrder.back()];
+                for (const auto candidate : readied) {
+                    if (!previous.empty() && attachments[candidate] == previous) {
+                        pass = candidate;
+                        break;
+                    }
+                }
+            }
+
+            if (pass == NoPass) {
+                ReadyQueue* queue = nullptr;
+                for (auto& candidate : ready) {
+                    // Passes picked for their attachments are still queued.
+                    while (!candidate.empty() && recorded[candidate.top().second])
+                        candidate.pop();
+
+                    if (!candidate.empty() && (queue == nullptr || candidate.top() < queue->top()))
+                        queue = &candidate;
+                }
+
+                if (reorder && !plan.executionOrder.empty()) {
+                    auto& sameType = getQueue(plan.executionOrder.back());
+                    if (!sameType.empty())
+                        queue = &sameType;
+                }
+
+                if (queue == nullptr)
+                    break;
+
+                pass = queue->top().second;
+                queue->pop();
+            }
+
+            recorded[pass] = true;
+            positions[pass] = static_cast<uint32_t>(plan.executionOrder.size());
+            plan.executionOrder.push_back(pass);
+
+            readied.clear();
+            for (const auto dependent : dependents[pass])
+                if (--pendingDependencies[dependent] == 0)
+                    makeReady(dependent);
+        }
+
+        if (plan.executionOrder.size() != alivePassCount)
+            throw std::logic_error{"Frame graph contains a dependency cycle"};
+    }
+
+    void FrameGraph::scheduleAsyncCompute(CompiledFrameGraph& plan) const {
+        const auto passCount = renderPasses.size();
+
+        const auto getResourceIndex = [](const ResourceUsage& usage) {
+            const auto [input, output] = getUsageIds(usage);
+            return input.isValid() ? input.index : output.index;
+        };
+
+        // Imported resources are owned by the graphics queue.
+        std::vector<bool> asyncCompute(passCount, false);
+        for (const auto pass : plan.executionOrder)
+            asyncCompute[pass] = renderPasses[pass].getType() == RenderPassType::Compute &&
+                                 std::ranges::none_of(
+                                     renderPasses[pass].getResourceUsages(),
+                                     [&](const ResourceUsage& usage) {
+                                         return resources[getResourceIndex(usage)].lifetime ==
+                                                ResourceLifetime::Imported;
+                                     }
+                                 );
+
+        /*
+         * Graphics passes that do not depend on async compute are recorded ahead of it, so they can overlap with it,
+         * and the rest after it, once the graphics queue has waited for the async compute work. A resource used both
+         * ahead of and on the async compute queue would be accessed by both queues at once, so async compute passes
+         * using such a resource are moved back to the graphics queue until no such resource remains.
+         */
+        std::vector<bool> afterAsyncCompute(passCount, false);
+        bool changed = true;
+        while (changed) {
+            changed = false;
+
+            for (const auto pass : plan.executionOrder) {
+                const auto& dependencies = plan.dependencies[pass];
+                if (asyncCompute[pass] && !std::ranges::all_of(
+                        dependencies,
+                        [&](const uint32_t dependency) { return asyncCompute[dependency]; }
+                    ))
+                    asyncCompute[pass] = false;
+
+                afterAsyncCompute[pass] = !asyncCompute[pass] && std::ranges::any_of(
+                    dependencies,
+                    [&](const uint32_t dependency) {
+                        return asyncCompute[dependency] || afterAsyncCompute[dependency];
+                    }
+                );
+            }
+
+            std::vector<bool> usedAhead(resources.size(), false);
+            for (const auto pass : plan.executionOrder) {
+                if (asyncCompute[pass] || afterAsyncCompute[pass])
+                    continue;
+
+                for (const auto& usage : renderPasses[pass].getResourceUsages())
+                    usedAhead[getResourceIndex(usage)] = true;
+            }
+
+            for (const auto pass : plan.executionOrder) {
+                if (!asyncCompute[pass])
+                    continue;
+
+                for (const auto& usage : renderPasses[pass].getResourceUsages()) {
+                    if (!usedAhead[getResourceIndex(usage)])
+                        continue;
+
+                    asyncCompute[pass] = false;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+
+        std::vector<uint32_t> order;
+        order.reserve(plan.executionOrder.size());
+        for (const auto pass : plan.executionOrder)
+            if (!asyncCompute[pass] && !afterAsyncCompute[pass])
+                order.push_back(pass);
+
+        plan.asyncComputeBegin = static_cast<uint32_t>(order.size());
+        for (const auto pass : plan.executionOrder)
+            if (asyncCompute[pass])
+                order.push_back(pass);
+
+        plan.asyncComputeEnd = static_cast<uint32_t>(order.size());
+        for (const auto pass : plan.executionOrder)
+            if (afterAsyncCompute[pass])
+                order.push_back(pass);
+
+        plan.executionOrder = std::move(order);
+    }
+
+    std::pmr::vector<uint64_t> FrameGraph::getStructure(const FrameGraphCompileOptions& options) const {
+        std::pmr::vector<uint64_t> structure{resources.get_allocator()};
+
+        appendStructure(
+            structure,
+            options.graphicsQueueFamily,
+            options.asyncComputeQueueFamily.has_value(),
+            options.asyncComputeQueueFamily.value_or(0),
+            options.reorderPasses
+        );
+
+        appendStructure(structure, resources.size());
+        for (const auto& resource : resources) {
+            appendStructure(structure, resource.type, resource.lifetime, resource.latestVersion);
+
+            if (const auto* description = std::get_if<ImageResourceDescription>(&resource.description)) {
+                const auto& [format, view] = *description;
+                appendStructure(
+                    structure,
+                    format.format,
+                    format.width,
+                    format.height,
+                    format.depth,
+                    format.layerCount,
+                    format.mipmapCount,
+                    format.type,
+                    format.samples,
+                    format.usage.value(),
+                    view.format,
+                    view.swizzleRed,
+                    view.swizzleGreen,
+                    view.swizzleBlue,
+                    view.swizzleAlpha
+                );
+            } else {
+                const auto& format = std::get<BufferFormat>(resource.description);
+                appendStructure(structure, format.count, format.stride, format.usage.value());
+            }
+
+            appendStructure(structure, resource.initialState);
+            appendStructure(structure, resource.finalState);
+        }
+
+        appendStructure(structure, renderPasses.size());
+        for (const auto& pass : renderPasses) {
+            appendStructure(
+                structure,
+                pass.getNameHash(),
+                pass.getType(),
+                pass.hasSideEffects(),
+                pass.getResourceUsages().size()
+            );
+
+            for (const auto& usage : pass.getResourceUsages()) {
+                std::visit(
+                    [&structure, &usage](const auto& typedUsage) {
+                        appendStructure(
+                            structure,
+                            usage.index(),
+                            typedUsage.input.id.index,
+                            typedUsage.input.id.version,
+                            typedUsage.output.id.index,
+                            typedUsage.output.id.version,
+                            typedUsage.access,
+                            typedUsage.usage,
+                            typedUsage.stages.value()
+                        );
+                    },
+                    usage
+                );
+
+                if (const auto* imageUsage = std::get_if<ImageResourceUsage>(&usage)) {
+                    const auto& subresources = imageUsage->subresources;
+                    appendStructure(
+                        structure,
+                        subresources.baseMipmap,
+                        subresources.mipmapCount,
+                        subresources.baseLayer,
+                        subresources.layerCount
+                    );
+                } else {
+                    const auto& bufferUsage = std::get<BufferResourceUsage>(usage);
+                    appendStructure(structure, bufferUsage.offset, bufferUsage.size);
+                }
+            }
+
+            appendStructure(structure, pass.getColorAttachments().size());
+            for (const auto& attachment : pass.getColorAttachments())
+                appendStructure(structure, attachment);
+
+            appendStructure(structure, pass.getDepthStencilAttachment().has_value());
+            if (const auto& attachment = pass.getDepthStencilAttachment())
+                appendStructure(structure, *attachment);
+        }
+
+        return structure;
+    }
+
+    const CompiledFrameGraph& FrameGraph::compile(
+        FrameGraphCache& cache,
+        const FrameGraphCompileOptions& options
+    ) {
+        if (compiled)
+            return compile(options);
+
+        auto structure = getStructure(options);
+        const auto hash = hashStructure(structure);
+
+        if (auto plan = cache.find(hash, structure)) {
+            compiled = std::move(plan->compiled);
+            aliasingLayout = std::move(plan->aliasingLayout);
+        } else {
+            compile(options);
+            cache.insert(
+                hash,
+                std::vector<uint64_t>(structure.begin(), structure.end()),
+                compiled
+            );
+        }
+
+        this->cache = &cache;
+        structureHash = hash;
+
+        return *compiled;
+    }
+
+    const CompiledFrameGraph& FrameGraph::compile(const FrameGraphCompileOptions& options) {
+        if (compiled) {
+            if (compiled->options != options)
+                throw std::logic_error{"Frame graph has already been compiled with different options"};
+
+            return *compiled;
+        }
+
+        const auto passCount = static_cast<uint32_t>(renderPasses.size());
+
+        /*
+         * Versions are declared in order, so a single sweep in declaration order sees every producer before its
+         * consumers, and every reader of a version before the pass that writes the next one. Producers and readers are
+         * tracked per subresource, so passes that use disjoint mipmaps and layers of an image, or disjoint ranges of a
+         * buffer, do not depend on each other.
+         */
+        const auto subresourceLayout = getSubresourceLayout(resources, renderPasses);
+        std::vector<uint32_t> latestProducers(subresourceLayout.getCount(), NoPass);
+        std::vector<std::vector<uint32_t>> latestReaders(subresourceLayout.getCount());
+
+        std::vector<std::vector<uint32_t>> producers(passCount);
+        std::vector<std::vector<uint32_t>> dependencies(passCount);
+        std::vector<bool> roots(passCount, false);
+
+        for (uint32_t pass = 0; pass < passCount; ++pass) {
+            roots[pass] = renderPasses[pass].hasSideEffects();
+
+            for (const auto& usage : renderPasses[pass].getResourceUsages()) {
+                const auto [input, output] = getUsageIds(usage);
+                const uint32_t index = input.isValid() ? input.index : output.index;
+                const auto& resource = resources[index];
+
+                subresourceLayout.forEach(usage, resource, index, [&](const uint32_t subresource) {
+                    if (input.isValid()) {
+                        // An attachment loaded before anything wrote it is not loaded at all.
+                        if (latestProducers[subresource] == NoPass &&
+                            resource.lifetime == ResourceLifetime::Transient &&
+                            !isAttachmentUsage(usage))
+                            throw std::logic_error{
+                                "Pass '" + std::string{renderPasses[pass].getName()} +
+                                "' reads transient frame graph resource '" + std::string{resource.name} +
+                                "' before it is written"
+                            };
+
+                        if (latestProducers[subresource] != NoPass) {
+                            addUnique(producers[pass], latestProducers[subresource]);
+                            addUnique(dependencies[pass], latestProducers[subresource]);
+                        }
+
+                        if (!output.isValid())
+                            latestReaders[subresource].push_back(pass);
+                    }
+
+                    if (output.isValid()) {
+                        if (!input.isValid() && latestProducers[subresource] != NoPass)
+                            addUnique(dependencies[pass], latestProducers[subresource]);
+
+                        for (const auto reader : latestReaders[subresource])
+                            addUnique(dependencies[pass], reader);
+
+                        latestReaders[subresource].clear();
+                        latestProducers[subresource] = pass;
+                    }
+                });
+
+                if (output.isValid() && resource.lifetime != ResourceLifetime::Transient)
+                    roots[pass] = true;
+            }
+        }
+
+        // Producers always precede their consumers, so liveness propagates in a single reverse sweep.
+        std::vector<bool> alive(passCount, false);
+        for (uint32_t pass = passCount; pass-- > 0;) {
+            if (roots[pass])
+                alive[pass] = true;
+
+            if (!alive[pass])
+                continue;
+
+            for (const auto producer : producers[pass])
+                alive[producer] = true;
+        }
+
+        CompiledFrameGraph result{
+            .executionOrder = {},
+            .dependencies = std::vector<std::vector<uint32_t>>(passCount),
+            .culled = std::vector<bool>(passCount, false),
+            .passBarriers = {},
+            .continuesRendering = {},
+            .splitBarriers = {},
+            .splitSignals = {},
+            .splitWaits = {},
+            .attachmentActions = {},
+            .lazilyAllocated = {},
+            .finalBarriers = {},
+            .resourceIntervals = {},
+            .options = options,
+            .asyncComputeBegin = 0,
+            .asyncComputeEnd = 0,
+            .asyncComputeReleaseBarriers = {}
+        };
+
+        for (uint32_t pass = 0; pass < passCount; ++pass) {
+            result.culled[pass] = !alive[pass];
+            if (!alive[pass])
+                continue;
+
+            for (const auto dependency : dependencies[pass])
+                if (alive[dependency])
+                    result.dependencies[pass].push_back(dependency);
+        }
+
+        orderPasses(result);
+
+        if (options.asyncComputeQueueFamily)
+            scheduleAsyncCompute(result);
+
+        planBarriers(result);
+
+        mergeRenderPasses(result);
+
+        indexSplitBarriers(result);
+
+        inferAttachmentActions(result);
+
+        compiled = std::make_shared<const CompiledFrameGraph>(std::move(result));
+
+        return *compiled;
+    }
+
+    void FrameGraph::recordPasses(
+        CommandBuffer* commandBuffer,
+        RecordingScratch& scratch,
+        const std::size_t begin,
+        const std::size_t end
+    ) {
+        const auto& plan = *compiled;
+        auto& renderingDeviceDriver = resourcePool->getDriver();
+
+        const FrameGraphResources graphResources{physicalResources};
+        RenderPassContext context{
+            .driver = renderingDeviceDriver,
+            .commandBuffer = commandBuffer,
+            .resources = graphResources,
+            .gpuTime = std::nullopt
+        };
+
+        // Every slice resets its own queries, since slices may be submitted to different queues.
+        auto* queryPool = firstQuery ? profiler->getQueryPool() : nullptr;
+        if (queryPool != nullptr && begin < end)
+            renderingDeviceDriver.commandResetQueryPool(
+                commandBuffer,
+                queryPool,
+                *firstQuery + static_cast<uint32_t>(begin * 2),
+                static_cast<uint32_t>((end - begin) * 2)
+            );
+
+        for (std::size_t position = begin; position < end; ++position) {
+            recordSplitWaits(commandBuffer, scratch, plan.splitWaits[position]);
+
+            recordBarriers(commandBuffer, scratch, plan.passBarriers[position], &aliasingLayout->barriers[position]);
+
+            auto& pass = renderPasses[plan.executionOrder[position]];
+            const bool rendering = isRendering(pass);
+
+            if (rendering && !plan.continuesRendering[position]) {
+                // Merged passes load what the first one loaded, and store what the last one stores.
+                auto last = position;
+                while (last + 1 < plan.executionOrder.size() && plan.continuesRendering[last + 1])
+                    ++last;
+
+                const auto& actions = plan.attachmentActions[plan.executionOrder[position]];
+                const auto& lastActions = plan.attachmentActions[plan.executionOrder[last]];
+
+                RenderingInfo renderingInfo{};
+                scratch.colorAttachments.clear();
+                for (std::size_t i = 0; i < pass.getColorAttachments().size(); ++i) {
+                    const auto& attachment = pass.getColorAttachments()[i];
+                    auto* image = graphResources.get(attachment.handle);
+                    renderingInfo.extent = {image->format.width, image->format.height};
+                    scratch.colorAttachments.push_back(
+                        getAttachmentInfo(attachment, actions[i], image, ImageLayout::ColorAttachmentOptimal)
+                    );
+                    scratch.colorAttachments.back().storeAction = lastActions[i].storeAction;
+                }
+                renderingInfo.colorAttachments = scratch.colorAttachments;
+
+                if (const auto& attachment = pass.getDepthStencilAttachment()) {
+                    auto* image = graphResources.get(attachment->handle);
+                    renderingInfo.extent = {image->format.width, image->format.height};
+                    renderingInfo.depthStencilAttachment = getAttachmentInfo(
+                        *attachment,
+                        actions.back(),
+                        image,
+                        ImageLayout::DepthStencilAttachmentOptimal
+                    );
+                    renderingInfo.depthStencilAttachment->storeAction = lastActions.back().storeAction;
+                }
+
+                renderingDeviceDriver.commandBeginRenderPass(commandBuffer, renderingInfo);
+            }
+
+            // Timestamps wait for the commands before them, so the time of every pass includes its barriers.
+            renderingDeviceDriver.commandBeginLabel(commandBuffer, pass.getName(), getLabelColor(pass));
+            if (queryPool != nullptr) {
+                renderingDeviceDriver.commandWriteTimestamp(
+                    commandBuffer,
+                    queryPool,
+                    PipelineStageBits::AllCommands,
+                    *firstQuery + static_cast<uint32_t>(position * 2)
+                );
+                context.gpuTime = profiler->getGpuTime(pass.getNameHash());
+            }
+
+            const auto recordStart = std::chrono::steady_clock::now();
+            pass.execute(context);
+            recordTimes[position] = std::chrono::steady_clock::now() - recordStart;
+
+            if (queryPool != nullptr)
+                renderingDeviceDriver.commandWriteTimestamp(
+                    commandBuffer,
+                    queryPool,
+                    PipelineStageBits::AllCommands,
+                    *firstQuery + static_cast<uint32_t>(position * 2 + 1)
+                );
+            renderingDeviceDriver.commandEndLabel(commandBuffer);
+
+            if (rendering && (position + 1 == plan.executionOrder.size() || !plan.continuesRendering[position + 1]))
+                renderingDeviceDriver.commandEndRenderPass(commandBuffer);
+
+            for (const auto split : plan.splitSignals[position])
+                recordSplitSignal(commandBuffer, scratch, split);
+        }
+    }
+
+    void FrameGraph::execute(
+        RenderingDeviceDriver& renderingDeviceDriver,
+        CommandBuffer* commandBuffer
+    ) {
+        if (resourcePool != nullptr)
+            throw std::logic_error{"Frame graph has already been executed"};
+
+        ownedResourcePool = std::make_unique<FrameGraphResourcePool>(renderingDeviceDriver, 1, 0);
+        execute(*ownedResourcePool, commandBuffer);
+    }
+
+    void FrameGraph::execute(
+        FrameGraphResourcePool& pool,
+        CommandBuffer* commandBuffer
+    ) {
+        if (resourcePool != nullptr)
+            throw std::logic_error{"Frame graph has already been executed"};
+
+        const auto& plan = compiled ? *compiled : compile();
+        if (plan.hasAsyncCompute())
+            throw std::logic_error{"Frame graph with async compute passes must be executed on both queues"};
+
+        realizeResources(pool);
+
+        auto scratch = createRecordingScratch(1);
+        recordPasses(commandBuffer, scratch.front(), 0, plan.executionOrder.size());
+
+        recordBarriers(commandBuffer, scratch.front(), plan.finalBarriers);
+    }
+
+    void FrameGraph::execute(
+        FrameGraphResourcePool& pool,
+        CommandBuffer* commandBuffer,
+        ParallelPassRecorder& recorder
+    ) {
+        if (resourcePool != nullptr)
+            throw std::logic_error{"Frame graph has already been executed"};
+
+        const auto& plan = compiled ? *compiled : compile();
+        if (plan.hasAsyncCompute())
+            throw std::logic_error{"Frame graph with async compute passes must be executed on both queues"};
+
+        realizeResources(pool);
+
+        // Contiguous slices of the execution order keep every barrier ahead of the passes that depend on it once the
+        // secondary command buffers are executed in order.
+        const std::size_t passCount = plan.executionOrder.size();
+        const auto chunkCount = static_cast<uint32_t>(
+            std::min<std::size_t>(recorder.getThreadCount(), passCount)
+        );
+
+        // A render pass cannot span command buffers, so slices only begin where a render pass may begin.
+        std::pmr::vector<std::size_t> boundaries(chunkCount + 1, resources.get_allocator());
+        for (uint32_t chunk = 0; chunk <= chunkCount; ++chunk) {
+            auto& boundary = boundaries[chunk];
+            boundary = chunkCount != 0 ? passCount * chunk / chunkCount : 0;
+            while (boundary < passCount && boundary > 0 && plan.continuesRendering[boundary])
+                --boundary;
+        }
+
+        auto scratch = createRecordingScratch(std::max<std::size_t>(chunkCount, 1));
+        std::pmr::vector<CommandBuffer*> commandBuffers(chunkCount, resources.get_allocator());
+        recorder.record(
+            std::span{commandBuffers},
+            [this, &boundaries, &scratch](const uint32_t chunk, CommandBuffer* secondary) {
+                recordPasses(secondary, scratch[chunk], boundaries[chunk], boundaries[chunk + 1]);
+            }
+        );
+
+        if (!commandBuffers.empty())
+            pool.getDriver().commandExecuteCommandBuffers(commandBuffer, commandBuffers);
+
+        recordBarriers(commandBuffer, scratch.front(), plan.finalBarriers);
+    }
+
+    void FrameGraph::execute(
+        FrameGraphResourcePool& pool,
+        const AsyncComputeCommandBuffers& commandBuffers
+    ) {
+        if (resourcePool != nullptr)
+            throw std::logic_error{"Frame graph has already been executed"};
+
+        if (!compiled)
+            throw std::logic_error{"Frame graph must be compiled with an async compute queue family first"};
+
+        const auto& plan = *compiled;
+
+        realizeResources(pool);
+
+        auto scratch = createRecordingScratch(1);
+        recordPasses(commandBuffers.graphics, scratch.front(), 0, plan.asyncComputeBegin);
+
+        if (plan.hasAsyncCompute()) {
+            recordPasses(commandBuffers.asyncCompute, scratch.front(), plan.asyncComputeBegin, plan.asyncComputeEnd);
+            recordBarriers(commandBuffers.asyncCompute, scratch.front(), plan.asyncComputeReleaseBarriers);
+        }
+
+        recordPasses(
+            commandBuffers.graphicsAfterAsyncCompute,
+            scratch.front(),
+            plan.asyncComputeEnd,
+            plan.executionOrder.size()
+        );
+        recordBarriers(commandBuffers.graphicsAfterAsyncCompute, scratch.front(), plan.finalBarriers);
+    }
+
+    void FrameGraph::setProfiler(FrameGraphProfiler& profiler) {
+        if (resourcePool != nullptr)
+            throw std::logic_error{"Frame graph has already been executed"};
+
+        this->profiler = &profiler;
+    }
+
+    bool FrameGraph::isCompiled() const noexcept {
+        return compiled != nullptr;
+    }
+
+    const CompiledFrameGraph& FrameGraph::getCompiled() const {
+        if (!compiled)
+            throw std::logic_error{"Frame graph has not been compiled"};
+
+        return *compiled;
+    }
+
+    const std::pmr::vector<ResourceNode>& FrameGraph::getResources() const noexcept {
+        return resources;
+    }
+
+    const std::pmr::vector<RenderPass>& FrameGraph::getRenderPasses() const noexcept {
+        return renderPasses;
+    }
+
+    const AliasingPlan& FrameGraph::getAliasingPlan() const noexcept {
+        static const AliasingPlan empty{};
+
+        return aliasingLayout ? aliasingLayout->plan : empty;
+    }
+
+    const AliasingLayout* FrameGraph::getAliasingLayout() const noexcept {
+        return aliasingLayout.get();
+    }
+
+    const std::pmr::vector<std::chrono::nanoseconds>& FrameGraph::getRecordTimes() const noexcept {
+        return recordTimes;
+    }
+
+    void FrameGraph::Builder::beginPassDeclarations() {
+        declarations.advanced.clear();
+
+        if (++declarations.scope == 0) {
+            std::ranges::fill(declarations.scopes, 0);
+            declarations.scope = 1;
+        }
+    }
 
     ResourceId FrameGraph::Builder::addResource(
-        std::string name,
+        const FrameGraphName name,
         const ResourceType type,
         const ResourceLifetime lifetime,
         ResourceDescription description,
@@ -21,13 +2623,16 @@ namespace Vixen {
         std::optional<ResourceState> initialState,
         std::optional<ResourceState> finalState
     ) {
-        if (name.empty())
+        if (name.getName().empty())
             throw std::invalid_argument{"Frame graph resource name must not be empty"};
 
-        if (std::ranges::any_of(resources, [&](const ResourceNode& resource) {
-            return resource.name == name;
+        const auto [first, last] = resourceIndices.equal_range(name.getHash());
+        if (std::any_of(first, last, [&](const auto& entry) {
+            return resources[entry.second].name == name.getName();
         }))
-            throw std::invalid_argument{"A frame graph resource named '" + name + "' already exists"};
+            throw std::invalid_argument{
+                "A frame graph resource named '" + std::string{name.getName()} + "' already exists"
+            };
 
         if (resources.size() >= ResourceId::Invalid)
             throw std::overflow_error{"Frame graph resource limit exceeded"};
@@ -54,7 +2659,7 @@ namespace Vixen {
         const auto index = static_cast<uint32_t>(resources.size());
 
         resources.push_back({
-            .name = std::move(name),
+            .name = std::pmr::string{name.getName(), resources.get_allocator()},
             .type = type,
             .lifetime = lifetime,
             .description = description,
@@ -64,6 +2669,9 @@ namespace Vixen {
             .finalState = finalState
         });
 
+        resourceIndices.emplace(name.getHash(), index);
+        declarations.scopes.push_back(0);
+
         return ResourceId{
             .index = index,
             .version = 0
@@ -71,7 +2679,7 @@ namespace Vixen {
     }
 
     ImageHandle FrameGraph::Builder::createImage(
-        std::string name,
+        const FrameGraphName name,
         ImageResourceDescription description,
         const ResourceLifetime lifetime
     ) {
@@ -87,7 +2695,7 @@ namespace Vixen {
 
         return ImageHandle{
             .id = addResource(
-                std::move(name),
+                name,
                 ResourceType::Image,
                 lifetime,
                 description
@@ -96,7 +2704,7 @@ namespace Vixen {
     }
 
     BufferHandle FrameGraph::Builder::createBuffer(
-        std::string name,
+        const FrameGraphName name,
         BufferFormat description,
         const ResourceLifetime lifetime
     ) {
@@ -111,7 +2719,7 @@ namespace Vixen {
 
         return BufferHandle{
             .id = addResource(
-                std::move(name),
+                name,
                 ResourceType::Buffer,
                 lifetime,
                 description
@@ -120,14 +2728,14 @@ namespace Vixen {
     }
 
     ImageHandle FrameGraph::Builder::importImage(
-        std::string name,
+        const FrameGraphName name,
         Image& image,
         ImageState initialState,
         ImageState finalState
     ) {
         return ImageHandle{
             .id = addResource(
-                std::move(name),
+                name,
                 ResourceType::Image,
                 ResourceLifetime::Imported,
                 ImageResourceDescription{
@@ -142,14 +2750,14 @@ namespace Vixen {
     }
 
     BufferHandle FrameGraph::Builder::importBuffer(
-        std::string name,
+        const FrameGraphName name,
         Buffer& buffer,
         BufferState initialState,
         BufferState finalState
     ) {
         return BufferHandle{
             .id = addResource(
-                std::move(name),
+                name,
                 ResourceType::Buffer,
                 ResourceLifetime::Imported,
                 BufferFormat{
@@ -163,4 +2771,29 @@ namespace Vixen {
             )
         };
     }
+
+    HistoryImage FrameGraph::Builder::importHistoryImage(
+        const FrameGraphName name,
+        FrameGraphResourcePool& pool,
+        const ImageResourceDescription& description,
+        const ImageState state
+    ) {
+        const auto images = pool.acquireHistory(name.getHash(), description);
+        if (!images)
+            throw CantCreateError{
+                "Failed to create frame graph history image '" + std::string{name.getName()} + "'"
+            };
+
+        // Images of a history created this frame have not been moved into its state yet.
+        const auto initialState = images->valid ? state : ImageState{};
+
+        std::pmr::string previousName{name.getName(), resources.get_allocator()};
+        previousName += " (previous)";
+
+        return {
+            .current = importImage(name, *images->current, initialState, state),
+            .previous = importImage(std::string_view{previousName}, *images->previous, initialState, state),
+            .valid = images->valid
+        };
+    }
 }
@@ -1,10 +1,27 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "AliasingPlanner.h"
+#include "AsyncComputeCommandBuffers.h"
+#include "AttachmentInfo.h"
+#include "CompiledFrameGraph.h"
+#include "EventWait.h"
+#include "FrameGraphCompileOptions.h"
+#include "FrameGraphName.h"
+#include "FrameGraphResources.h"
 #include "Node.h"
 #include "RenderPass.h"
 #include "RenderPassType.h"
@@ -12,48 +29,322 @@
 namespace Vixen {
     class Buffer;
     struct Image;
+    struct CommandBuffer;
+    struct Event;
+    class FrameGraphCache;
+    class FrameGraphProfiler;
+    class FrameGraphResourcePool;
+    struct MemoryAllocation;
+    class ParallelPassRecorder;
+    class RenderingDeviceDriver;
 
     class FrameGraph final {
-        std::vector<ResourceNode> resources;
+        /**
+         * Storage the barriers and attachments of passes are converted into while they are recorded. It is reserved
+         * from the graph's allocator before recording begins, large enough for any single pass, so recording does not
+         * allocate and every command buffer recorded in parallel has its own.
+         */
+        struct RecordingScratch {
+            std::pmr::vector<MemoryBarrier> memoryBarriers;
 
-        std::vector<RenderPass> renderPasses;
+            std::pmr::vector<BufferBarrier> bufferBarriers;
 
-        FrameGraph(std::vector<ResourceNode>&& resources, std::vector<RenderPass>&& renderPasses);
+            std::pmr::vector<ImageBarrier> imageBarriers;
+
+            std::pmr::vector<EventWait> eventWaits;
+
+            std::pmr::vector<AttachmentInfo> colorAttachments;
+        };
+
+        std::pmr::vector<ResourceNode> resources;
+
+        std::pmr::vector<RenderPass> renderPasses;
+
+        std::shared_ptr<const CompiledFrameGraph> compiled;
+
+        /**
+         * The cache the compiled plan was looked up in, which also receives the aliasing layout once it is created.
+         */
+        FrameGraphCache* cache = nullptr;
+
+        uint64_t structureHash = 0;
+
+        FrameGraphResourcePool* resourcePool = nullptr;
+
+        /**
+         * The pool created for a graph executed without one, which destroys everything along with the graph.
+         */
+        std::unique_ptr<FrameGraphResourcePool> ownedResourcePool;
+
+        std::pmr::vector<ResourceObject> physicalResources;
+
+        std::shared_ptr<const AliasingLayout> aliasingLayout;
+
+        std::pmr::vector<MemoryAllocation*> transientHeaps;
+
+        /**
+         * Per split barrier of the compiled plan, the event it is signaled and waited on with.
+         */
+        std::pmr::vector<Event*> events;
+
+        /**
+         * Per position in the execution order, the CPU time the pass's execute callback took to record.
+         */
+        std::pmr::vector<std::chrono::nanoseconds> recordTimes;
+
+        FrameGraphProfiler* profiler = nullptr;
+
+        /**
+         * The first timestamp query reserved for the passes, or nullopt when the graph is not profiled.
+         */
+        std::optional<uint32_t> firstQuery;
+
+        FrameGraph(std::pmr::vector<ResourceNode>&& resources, std::pmr::vector<RenderPass>&& renderPasses);
+
+        /**
+         * Orders the passes that survived culling after the passes they depend on, either in declaration order or
+         * following the reordering heuristic, as the plan's options say.
+         */
+        void orderPasses(CompiledFrameGraph& plan) const;
+
+        void scheduleAsyncCompute(CompiledFrameGraph& plan) const;
+
+        void planBarriers(CompiledFrameGraph& plan) const;
+
+        /**
+         * Marks graphics passes that can be recorded into the render pass of the pass before them, moving their
+         * barriers ahead of that render pass.
+         */
+        void mergeRenderPasses(CompiledFrameGraph& plan) const;
+
+        /**
+         * Merges split barriers between the same two passes, caps the number at each position, and lists the ones
+         * signaled and waited on at every position.
+         */
+        static void indexSplitBarriers(CompiledFrameGraph& plan);
+
+        /**
+         * Drops the attachment loads and stores of surviving passes that no other pass depends on, and picks the
+         * transient images that can live in lazily allocated memory as a result.
+         */
+        void inferAttachmentActions(CompiledFrameGraph& plan) const;
+
+        void realizeResources(FrameGraphResourcePool& pool);
+
+        void releaseResources();
+
+        /**
+         * Whether the resource is placed into memory shared with other transient resources.
+         */
+        [[nodiscard]] bool isShared(uint32_t index) const;
+
+        [[nodiscard]] std::shared_ptr<const AliasingLayout> createAliasingLayout(
+            RenderingDeviceDriver& driver
+        ) const;
+
+        void planAliasingBarriers(AliasingLayout& layout) const;
+
+        /**
+         * Flattens everything the compiled plan depends on, the options, resource descriptions and pass usages, but
+         * not the execute callbacks or imported objects, into a sequence that is equal for structurally equal graphs.
+         */
+        [[nodiscard]] std::pmr::vector<uint64_t> getStructure(const FrameGraphCompileOptions& options) const;
+
+        /**
+         * Records the passes at positions [begin, end) of the execution order, each preceded by its barriers.
+         */
+        void recordPasses(
+            CommandBuffer* commandBuffer,
+            RecordingScratch& scratch,
+            std::size_t begin,
+            std::size_t end
+        );
+
+        /**
+         * Creates scratch storage for as many command buffers recorded at the same time.
+         */
+        [[nodiscard]] std::pmr::vector<RecordingScratch> createRecordingScratch(std::size_t count) const;
+
+        void recordBarriers(
+            CommandBuffer* commandBuffer,
+            RecordingScratch& scratch,
+            const BarrierBatch& batch,
+            const BarrierBatch* aliasing = nullptr
+        ) const;
+
+        /**
+         * Records the signaling half of a split barrier.
+         */
+        void recordSplitSignal(
+            CommandBuffer* commandBuffer,
+            RecordingScratch& scratch,
+            uint32_t split
+        ) const;
+
+        /**
+         * Records the waiting halves of the split barriers as a single wait, followed by a reset of their events.
+         */
+        void recordSplitWaits(
+            CommandBuffer* commandBuffer,
+            RecordingScratch& scratch,
+            std::span<const uint32_t> splits
+        ) const;
+
+        void appendBufferBarriers(
+            const BarrierBatch& batch,
+            std::pmr::vector<BufferBarrier>& bufferBarriers
+        ) const;
+
+        void appendImageBarriers(
+            const BarrierBatch& batch,
+            std::pmr::vector<ImageBarrier>& imageBarriers
+        ) const;
 
     public:
         FrameGraph(const FrameGraph& other) = delete;
 
-        FrameGraph(FrameGraph&& other) noexcept = default;
+        FrameGraph(FrameGraph&& other) noexcept;
 
         FrameGraph& operator=(const FrameGraph& other) = delete;
 
-        FrameGraph& operator=(FrameGraph&& other) noexcept = default;
+        FrameGraph& operator=(FrameGraph&& other) noexcept;
+
+        /**
+         * Returns the physical resources created when the graph was executed to the pool it was executed with, or
+         * destroys them if it was executed without one. In the latter case the graph must be kept alive until the GPU
+         * has finished the work recorded from it.
+         */
+        ~FrameGraph();
+
+        /**
+         * Builds the producer/consumer graph from the versioned resource usages of every pass, culls passes whose
+         * outputs never reach an imported or persistent resource or a pass with side effects, and orders the
+         * remaining passes. When the options name an async compute queue family, compute passes that depend on no
+         * graphics work are scheduled on that queue. Compiling an already compiled graph returns the existing result,
+         * and throws if it was compiled with different options.
+         */
+        const CompiledFrameGraph& compile(const FrameGraphCompileOptions& options = {});
+
+        /**
+         * Compiles the graph like above, but first looks for the plan of a structurally identical graph in the cache,
+         * and shares its execution order, barriers and aliasing layout instead of compiling again. Graphs rebuilt
+         * every frame with the same passes and resources therefore only pay for hashing their structure.
+         */
+        const CompiledFrameGraph& compile(
+            FrameGraphCache& cache,
+            const FrameGraphCompileOptions& options = {}
+        );
+
+        /**
+         * Compiles the graph if needed, creates its transient resources, placing those with disjoint lifetimes into
+         * shared memory, and records every surviving pass into the
+         * command buffer in execution order, preceded by the barriers the compiled plan requires at each pass
+         * boundary. Graphics passes with attachments are wrapped in a render pass.
+         */
+        void execute(
+            RenderingDeviceDriver& renderingDeviceDriver,
+            CommandBuffer* commandBuffer
+        );
+
+        /**
+         * Executes the graph like above, but takes its physical resources from the pool and hands them back when the
+         * graph is destroyed, so graphs rebuilt every frame reuse the images, buffers and heaps of earlier frames.
+         */
+        void execute(
+            FrameGraphResourcePool& pool,
+            CommandBuffer* commandBuffer
+        );
+
+        /**
+         * Executes the graph like above, but splits the execution order into contiguous slices that are recorded
+         * concurrently into secondary command buffers, which are then executed in order from the primary command
+         * buffer. The execute callbacks of passes are invoked from the recorder's threads, so they must not share
+         * unsynchronized state with each other, and must only record into the command buffer of their context.
+         */
+        void execute(
+            FrameGraphResourcePool& pool,
+            CommandBuffer* commandBuffer,
+            ParallelPassRecorder& recorder
+        );
+
+        /**
+         * Executes a graph compiled with an async compute queue family, recording the async compute passes along with
+         * the release of resources handed over to the graphics queue into their own command buffer, and the graphics
+         * passes on either side of them into the graphics command buffers.
+         */
+        void execute(
+            FrameGraphResourcePool& pool,
+            const AsyncComputeCommandBuffers& commandBuffers
+        );
+
+        /**
+         * Writes timestamps before and after every pass once the graph is executed, which the profiler reads back
+         * after the GPU has finished the frame. Graphs executed after the frame has run out of timestamp queries are
+         * not measured.
+         */
+        void setProfiler(FrameGraphProfiler& profiler);
+
+        [[nodiscard]] bool isCompiled() const noexcept;
+
+        [[nodiscard]] const CompiledFrameGraph& getCompiled() const;
+
+        [[nodiscard]] const std::pmr::vector<ResourceNode>& getResources() const noexcept;
+
+        [[nodiscard]] const std::pmr::vector<RenderPass>& getRenderPasses() const noexcept;
+
+        /**
+         * The placement of transient resources into shared heaps, along with the memory saved over giving each its
+         * own allocation. Empty until the graph has been executed.
+         */
+        [[nodiscard]] const AliasingPlan& getAliasingPlan() const noexcept;
+
+        /**
+         * The aliasing plan along with the resource each placement belongs to, or null until the graph has been
+         * executed.
+         */
+        [[nodiscard]] const AliasingLayout* getAliasingLayout() const noexcept;
+
+        /**
+         * Per position in the execution order, the CPU time the pass took to record. Empty until the graph has been
+         * executed.
+         */
+        [[nodiscard]] const std::pmr::vector<std::chrono::nanoseconds>& getRecordTimes() const noexcept;
+
+        /**
+         * Builds a frame graph whose names, usages, execute callbacks and execution state are all allocated from one
+         * memory resource. Building from a FrameGraphArena that is reset every frame keeps graphs rebuilt every frame
+         * off the global heap.
+         */
+        class Builder {
+            std::pmr::vector<ResourceNode> resources;
+
+            std::pmr::vector<RenderPass> renderPasses;
 
-        ~FrameGraph() = default;
+            /**
+             * Resource indices by the hash of their name.
+             */
+            std::pmr::unordered_multimap<uint64_t, uint32_t> resourceIndices;
 
-        class Builder {
-            std::vector<ResourceNode> resources;
+            PassDeclarations declarations;
 
-            std::vector<RenderPass> renderPasses;
+            void beginPassDeclarations();
 
             template <typename PassData, typename Setup, typename Execute>
             Builder& addPass(
-                std::string name,
+                const FrameGraphName name,
                 const RenderPassType type,
                 Setup&& setup,
                 Execute&& execute
             ) {
-                std::vector<uint32_t> versionsBefore;
-                versionsBefore.reserve(resources.size());
-                for (const auto& resource : resources)
-                    versionsBefore.push_back(resource.latestVersion);
+                beginPassDeclarations();
 
                 try {
                     PassData data{};
 
                     RenderPass::Builder passBuilder{
                         resources,
-                        std::move(name),
+                        declarations,
+                        name,
                         type
                     };
 
@@ -66,8 +357,8 @@ namespace Vixen {
                         )
                     );
                 } catch (...) {
-                    for (std::size_t i = 0; i < versionsBefore.size(); ++i)
-                        resources[i].latestVersion = versionsBefore[i];
+                    for (const auto& [index, version] : declarations.advanced)
+                        resources[index].latestVersion = version;
 
                     throw;
                 }
@@ -76,7 +367,7 @@ namespace Vixen {
             }
 
             ResourceId addResource(
-                std::string name,
+                FrameGraphName name,
                 ResourceType type,
                 ResourceLifetime lifetime,
                 ResourceDescription description,
@@ -86,7 +377,19 @@ namespace Vixen {
             );
 
         public:
-            Builder() = default;
+            /**
+             * @param memoryResource The resource everything the graph allocates comes from, which must outlive the
+             * graph.
+             */
+            explicit Builder(
+                std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource()
+            ) : resources(memoryResource),
+                renderPasses(memoryResource),
+                resourceIndices(memoryResource),
+                declarations{
+                    .scopes = std::pmr::vector<uint32_t>(memoryResource),
+                    .advanced = std::pmr::vector<ResourceId>(memoryResource)
+                } {}
 
             Builder(const Builder& other) = delete;
 
@@ -100,12 +403,12 @@ namespace Vixen {
 
             template <typename PassData, typename Setup, typename Execute>
             Builder& addGraphicsPass(
-                std::string name,
+                const FrameGraphName name,
                 Setup&& setup,
                 Execute&& execute
             ) {
                 return addPass<PassData>(
-                    std::move(name),
+                    name,
                     RenderPassType::Graphics,
                     std::forward<Setup>(setup),
                     std::forward<Execute>(execute)
@@ -114,12 +417,12 @@ namespace Vixen {
 
             template <typename PassData, typename Setup, typename Execute>
             Builder& addComputePass(
-                std::string name,
+                const FrameGraphName name,
                 Setup&& setup,
                 Execute&& execute
             ) {
                 return addPass<PassData>(
-                    std::move(name),
+                    name,
                     RenderPassType::Compute,
                     std::forward<Setup>(setup),
                     std::forward<Execute>(execute)
@@ -127,31 +430,48 @@ namespace Vixen {
             }
 
             ImageHandle createImage(
-                std::string name,
+                FrameGraphName name,
                 ImageResourceDescription description,
                 ResourceLifetime lifetime = ResourceLifetime::Transient
             );
 
             BufferHandle createBuffer(
-                std::string name,
+                FrameGraphName name,
                 BufferFormat description,
                 ResourceLifetime lifetime = ResourceLifetime::Transient
             );
 
             ImageHandle importImage(
-                std::string name,
+                FrameGraphName name,
                 Image& image,
                 ImageState initialState,
                 ImageState finalState
             );
 
             BufferHandle importBuffer(
-                std::string name,
+                FrameGraphName name,
                 Buffer& buffer,
                 BufferState initialState,
                 BufferState finalState
             );
 
+            /**
+             * Imports the history kept under the name by the pool, a pair of images that trade places every frame, so
+             * temporal passes read the last frame's contents without copying them. Both images are left in the given
+             * state at the end of the graph, and start out in it the next frame. The graph must be executed with the
+             * same pool, and a history used by at most one graph per frame.
+             */
+            HistoryImage importHistoryImage(
+                FrameGraphName name,
+                FrameGraphResourcePool& pool,
+                const ImageResourceDescription& description,
+                ImageState state = {
+                    .stages = PipelineStageBits::FragmentShader | PipelineStageBits::ComputeShader,
+                    .access = BarrierAccessBits::ShaderRead,
+                    .layout = ImageLayout::ShaderReadOnlyOptimal
+                }
+            );
+
             [[nodiscard]] FrameGraph build() && {
                 return FrameGraph{
                     std::move(resources),
@@ -0,0 +1,81 @@
+#include "FrameGraphArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace Vixen {
+    void FrameGraphArena::addBlock(const std::size_t size) {
+        blocks.reserve(blocks.size() + 1);
+        blocks.push_back({
+            .memory = static_cast<std::byte*>(::operator new(size, std::align_val_t{alignof(std::max_align_t)})),
+            .size = size
+        });
+        offset = 0;
+    }
+
+    void FrameGraphArena::releaseBlocks() noexcept {
+        for (const auto& [memory, size] : blocks)
+            ::operator delete(memory, size, std::align_val_t{alignof(std::max_align_t)});
+
+        blocks.clear();
+    }
+
+    void* FrameGraphArena::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+        if (!blocks.empty()) {
+            const auto& [memory, size] = blocks.back();
+            const auto address = reinterpret_cast<std::uintptr_t>(memory) + offset;
+            const auto padding = (alignment - address % alignment) % alignment;
+
+            if (offset + padding + bytes <= size) {
+                offset += padding + bytes;
+                used += padding + bytes;
+
+                return memory + offset - bytes;
+            }
+        }
+
+        // Blocks double in size, so a frame that keeps growing needs few of them until the next reset merges them.
+        const auto last = blocks.empty() ? DefaultCapacity : blocks.back().size;
+        addBlock(std::max(last * 2, bytes + alignment));
+
+        return do_allocate(bytes, alignment);
+    }
+
+    void FrameGraphArena::do_deallocate(void*, std::size_t, std::size_t) {}
+
+    bool FrameGraphArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    FrameGraphArena::FrameGraphArena(const std::size_t capacity) {
+        addBlock(std::max<std::size_t>(capacity, 1));
+    }
+
+    FrameGraphArena::~FrameGraphArena() {
+        releaseBlocks();
+    }
+
+    void FrameGraphArena::reset() {
+        if (blocks.size() > 1) {
+            const auto capacity = getCapacity();
+            releaseBlocks();
+            addBlock(capacity);
+        }
+
+        offset = 0;
+        used = 0;
+    }
+
+    std::size_t FrameGraphArena::getUsed() const noexcept {
+        return used;
+    }
+
+    std::size_t FrameGraphArena::getCapacity() const noexcept {
+        std::size_t capacity = 0;
+        for (const auto& block : blocks)
+            capacity += block.size;
+
+        return capacity;
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace Vixen {
+    /**
+     * A linear allocator for everything a frame graph allocates while it is built and executed. Deallocation is a
+     * no-op, and all memory is reclaimed at once when the arena is reset. When a frame outgrows the arena, the extra
+     * blocks are merged into one on reset, so a frame that builds the same graph again allocates nothing from the
+     * global heap.
+     */
+    class FrameGraphArena final : public std::pmr::memory_resource {
+    public:
+        static constexpr std::size_t DefaultCapacity = 64 * 1024;
+
+    private:
+        struct Block {
+            std::byte* memory;
+
+            std::size_t size;
+        };
+
+        std::vector<Block> blocks;
+
+        /**
+         * The offset of the first free byte in the last block.
+         */
+        std::size_t offset = 0;
+
+        std::size_t used = 0;
+
+        void addBlock(std::size_t size);
+
+        void releaseBlocks() noexcept;
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    public:
+        explicit FrameGraphArena(
+            std::size_t capacity = DefaultCapacity
+        );
+
+        FrameGraphArena(const FrameGraphArena& other) = delete;
+
+        FrameGraphArena(FrameGraphArena&& other) noexcept = delete;
+
+        FrameGraphArena& operator=(const FrameGraphArena& other) = delete;
+
+        FrameGraphArena& operator=(FrameGraphArena&& other) noexcept = delete;
+
+        ~FrameGraphArena() override;
+
+        /**
+         * Reclaims every allocation at once. Nothing allocated from the arena may be used afterwards, so every graph
+         * built with it must have been destroyed.
+         */
+        void reset();
+
+        /**
+         * The bytes handed out since the last reset, including alignment padding.
+         */
+        [[nodiscard]] std::size_t getUsed() const noexcept;
+
+        [[nodiscard]] std::size_t getCapacity() const noexcept;
+    };
+}
@@ -0,0 +1,84 @@
+#include "FrameGraphCache.h"
+
+#include <algorithm>
+
+#include "AliasingPlanner.h"
+#include "CompiledFrameGraph.h"
+
+namespace Vixen {
+    FrameGraphCache::FrameGraphCache(
+        const uint32_t capacity
+    ) : capacity(std::max(capacity, 1u)) {}
+
+    auto FrameGraphCache::find(
+        const uint64_t hash,
+        const std::span<const uint64_t> structure
+    ) -> std::optional<Plan> {
+        const auto it = entries.find(hash);
+        if (it == entries.end() || !std::ranges::equal(it->second.structure, structure)) {
+            ++missCount;
+            return std::nullopt;
+        }
+
+        ++hitCount;
+        it->second.lastUse = ++useCount;
+
+        return it->second.plan;
+    }
+
+    void FrameGraphCache::insert(
+        const uint64_t hash,
+        std::vector<uint64_t> structure,
+        std::shared_ptr<const CompiledFrameGraph> compiled
+    ) {
+        entries.insert_or_assign(
+            hash,
+            Entry{
+                .structure = std::move(structure),
+                .plan = {
+                    .compiled = std::move(compiled),
+                    .aliasingLayout = nullptr
+                },
+                .lastUse = ++useCount
+            }
+        );
+
+        if (entries.size() <= capacity)
+            return;
+
+        const auto leastRecentlyUsed = std::ranges::min_element(
+            entries,
+            {},
+            [](const auto& entry) { return entry.second.lastUse; }
+        );
+        entries.erase(leastRecentlyUsed);
+    }
+
+    void FrameGraphCache::setAliasingLayout(
+        const uint64_t hash,
+        const CompiledFrameGraph* compiled,
+        std::shared_ptr<const AliasingLayout> aliasingLayout
+    ) {
+        const auto it = entries.find(hash);
+        if (it == entries.end() || it->second.plan.compiled.get() != compiled)
+            return;
+
+        it->second.plan.aliasingLayout = std::move(aliasingLayout);
+    }
+
+    void FrameGraphCache::clear() noexcept {
+        entries.clear();
+    }
+
+    std::size_t FrameGraphCache::getSize() const noexcept {
+        return entries.size();
+    }
+
+    uint64_t FrameGraphCache::getHitCount() const noexcept {
+        return hitCount;
+    }
+
+    uint64_t FrameGraphCache::getMissCount() const noexcept {
+        return missCount;
+    }
+}
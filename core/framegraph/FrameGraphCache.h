@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Vixen {
+    struct AliasingLayout;
+    struct CompiledFrameGraph;
+
+    /**
+     * Keeps the compiled plans of recently executed frame graphs under a hash of their structure, so a graph with the
+     * same passes, usages and resource descriptions as an earlier one reuses its plan instead of being compiled again.
+     * The least recently used plan is dropped once more plans than the capacity are held.
+     */
+    class FrameGraphCache final {
+    public:
+        static constexpr uint32_t DefaultCapacity = 16;
+
+        struct Plan {
+            std::shared_ptr<const CompiledFrameGraph> compiled;
+
+            /**
+             * Set once a graph with this plan has been executed.
+             */
+            std::shared_ptr<const AliasingLayout> aliasingLayout;
+        };
+
+    private:
+        struct Entry {
+            /**
+             * The tokens the hash was computed from, compared on lookup so that colliding structures are told apart.
+             */
+            std::vector<uint64_t> structure;
+
+            Plan plan;
+
+            uint64_t lastUse;
+        };
+
+        uint32_t capacity;
+
+        uint64_t useCount = 0;
+
+        uint64_t hitCount = 0;
+
+        uint64_t missCount = 0;
+
+        std::unordered_map<uint64_t, Entry> entries;
+
+    public:
+        explicit FrameGraphCache(
+            uint32_t capacity = DefaultCapacity
+        );
+
+        /**
+         * Returns the plan of a graph with the given structure, if one is cached.
+         */
+        [[nodiscard]] std::optional<Plan> find(
+            uint64_t hash,
+            std::span<const uint64_t> structure
+        );
+
+        void insert(
+            uint64_t hash,
+            std::vector<uint64_t> structure,
+            std::shared_ptr<const CompiledFrameGraph> compiled
+        );
+
+        /**
+         * Stores the aliasing layout created for the compiled plan, unless the plan has been dropped in the meantime.
+         */
+        void setAliasingLayout(
+            uint64_t hash,
+            const CompiledFrameGraph* compiled,
+            std::shared_ptr<const AliasingLayout> aliasingLayout
+        );
+
+        void clear() noexcept;
+
+        [[nodiscard]] std::size_t getSize() const noexcept;
+
+        [[nodiscard]] uint64_t getHitCount() const noexcept;
+
+        [[nodiscard]] uint64_t getMissCount() const noexcept;
+    };
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace Vixen {
+    struct FrameGraphCompileOptions {
+        /**
+         * The queue family the graph's graphics work is submitted on, which receives ownership of resources handed
+         * over from the async compute queue.
+         */
+        uint32_t graphicsQueueFamily = 0;
+
+        /**
+         * When set, compute passes that depend on no graphics work are scheduled on a separate queue of this family,
+         * so they can overlap with the graphics passes that do not depend on them.
+         */
+        std::optional<uint32_t> asyncComputeQueueFamily = std::nullopt;
+
+        /**
+         * When set, the passes are reordered within their dependencies to keep passes rendering to the same
+         * attachments and passes of the same type together, and to move consumers away from their producers, which
+         * saves layout transitions and gives barriers room to overlap. Otherwise they are recorded in the order they
+         * were declared in, which is easier to follow when debugging.
+         */
+        bool reorderPasses = true;
+
+        bool operator==(const FrameGraphCompileOptions& other) const = default;
+    };
+}
@@ -0,0 +1,368 @@
+#include "FrameGraphExporter.h"
+
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "FrameGraph.h"
+
+namespace Vixen {
+    namespace {
+        struct VersionUse {
+            uint32_t resource;
+
+            std::optional<uint32_t> inputVersion;
+
+            std::optional<uint32_t> outputVersion;
+        };
+
+        std::vector<VersionUse> getVersionUses(const RenderPass& pass) {
+            std::vector<VersionUse> uses;
+            for (const auto& usage : pass.getResourceUsages()) {
+                std::visit(
+                    [&uses](const auto& typedUsage) {
+                        const auto input = typedUsage.input.id;
+                        const auto output = typedUsage.output.id;
+                        uses.push_back({
+                            .resource = input.isValid() ? input.index : output.index,
+                            .inputVersion = input.isValid() ? std::optional{input.version} : std::nullopt,
+                            .outputVersion = output.isValid() ? std::optional{output.version} : std::nullopt
+                        });
+                    },
+                    usage
+                );
+            }
+
+            return uses;
+        }
+
+        std::string escape(const std::string_view text) {
+            std::string escaped;
+            escaped.reserve(text.size());
+            for (const char character : text) {
+                switch (character) {
+                    case '"':
+                        escaped += "\\\"";
+                        break;
+                    case '\\':
+                        escaped += "\\\\";
+                        break;
+                    case '\n':
+                        escaped += "\\n";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(character) >= 0x20)
+                            escaped += character;
+                }
+            }
+
+            return escaped;
+        }
+
+        std::string_view toString(const RenderPassType type) {
+            switch (type) {
+                case RenderPassType::Graphics:
+                    return "graphics";
+                case RenderPassType::Compute:
+                    return "compute";
+            }
+
+            std::unreachable();
+        }
+
+        std::string_view toString(const ResourceType type) {
+            switch (type) {
+                case ResourceType::Image:
+                    return "image";
+                case ResourceType::Buffer:
+                    return "buffer";
+            }
+
+            std::unreachable();
+        }
+
+        std::string_view toString(const ResourceLifetime lifetime) {
+            switch (lifetime) {
+                case ResourceLifetime::Transient:
+                    return "transient";
+                case ResourceLifetime::Persistent:
+                    return "persistent";
+                case ResourceLifetime::Imported:
+                    return "imported";
+            }
+
+            std::unreachable();
+        }
+
+        double toMilliseconds(const std::chrono::nanoseconds time) {
+            return std::chrono::duration<double, std::milli>(time).count();
+        }
+
+        void writeJsonTime(std::ostream& stream, const std::optional<std::chrono::nanoseconds> time) {
+            if (time)
+                stream << time->count();
+            else
+                stream << "null";
+        }
+
+        void writeJsonVersions(
+            std::ostream& stream,
+            const std::vector<VersionUse>& uses,
+            std::optional<uint32_t> VersionUse::* version
+        ) {
+            stream << '[';
+            bool first = true;
+            for (const auto& use : uses) {
+                if (!(use.*version))
+                    continue;
+
+                stream << (first ? "" : ", ") << "{\"resource\": " << use.resource
+                    << ", \"version\": " << *(use.*version) << '}';
+                first = false;
+            }
+            stream << ']';
+        }
+
+        std::string getVersionNode(const uint32_t resource, const uint32_t version) {
+            return "r" + std::to_string(resource) + "v" + std::to_string(version);
+        }
+    }
+
+    FrameGraphExporter::FrameGraphExporter(
+        const FrameGraph& graph,
+        std::vector<std::optional<std::chrono::nanoseconds>> gpuTimes
+    ) : graph(graph),
+        gpuTimes(std::move(gpuTimes)),
+        positions(graph.getRenderPasses().size()),
+        heaps(graph.getResources().size()) {
+        const auto& executionOrder = graph.getCompiled().executionOrder;
+        for (uint32_t position = 0; position < executionOrder.size(); ++position)
+            positions[executionOrder[position]] = position;
+
+        if (const auto* layout = graph.getAliasingLayout()) {
+            for (std::size_t i = 0; i < layout->requests.size(); ++i)
+                heaps[layout->requests[i].resource] = layout->plan.placements[i].heap;
+        }
+    }
+
+    std::optional<std::chrono::nanoseconds> FrameGraphExporter::getRecordTime(
+        const std::optional<uint32_t> position
+    ) const {
+        const auto& recordTimes = graph.getRecordTimes();
+        if (!position || *position >= recordTimes.size())
+            return std::nullopt;
+
+        return recordTimes[*position];
+    }
+
+    std::optional<std::chrono::nanoseconds> FrameGraphExporter::getGpuTime(
+        const std::optional<uint32_t> position
+    ) const {
+        if (!position || *position >= gpuTimes.size())
+            return std::nullopt;
+
+        return gpuTimes[*position];
+    }
+
+    void FrameGraphExporter::writeGraphViz(std::ostream& stream) const {
+        const auto& compiled = graph.getCompiled();
+        const auto& resources = graph.getResources();
+        const auto& renderPasses = graph.getRenderPasses();
+
+        stream << "digraph FrameGraph {\n";
+        stream << "    rankdir=LR;\n";
+        stream << "    node [fontname=\"Helvetica\", fontsize=10];\n";
+        stream << "    edge [fontname=\"Helvetica\", fontsize=9];\n";
+
+        std::set<std::pair<uint32_t, uint32_t>> versions;
+        for (uint32_t index = 0; index < renderPasses.size(); ++index) {
+            const auto& pass = renderPasses[index];
+            const auto position = positions[index];
+
+            stream << "    p" << index << " [shape=box, label=\"" << escape(pass.getName()) << "\\n"
+                << toString(pass.getType());
+            if (position)
+                stream << " #" << *position;
+            else
+                stream << " (culled)";
+
+            if (const auto time = getRecordTime(position))
+                stream << "\\ncpu " << toMilliseconds(*time) << " ms";
+            if (const auto time = getGpuTime(position))
+                stream << "\\ngpu " << toMilliseconds(*time) << " ms";
+
+            if (position) {
+                const auto& batch = compiled.passBarriers[*position];
+                if (!batch.empty())
+                    stream << "\\nbarriers: " << batch.imageBarriers.size() << " image, "
+                        << batch.bufferBarriers.size() << " buffer";
+                if (compiled.continuesRendering[*position])
+                    stream << "\\nmerged into previous render pass";
+            }
+            stream << '"';
+
+            if (!position)
+                stream << ", style=dashed, color=gray50, fontcolor=gray50";
+            else if (compiled.hasAsyncCompute() &&
+                     *position >= compiled.asyncComputeBegin &&
+                     *position < compiled.asyncComputeEnd)
+                stream << ", style=filled, fillcolor=lightyellow";
+            stream << "];\n";
+
+            for (const auto& use : getVersionUses(pass)) {
+                if (use.inputVersion) {
+                    versions.emplace(use.resource, *use.inputVersion);
+                    stream << "    " << getVersionNode(use.resource, *use.inputVersion) << " -> p" << index << ";\n";
+                }
+                if (use.outputVersion) {
+                    versions.emplace(use.resource, *use.outputVersion);
+                    stream << "    p" << index << " -> " << getVersionNode(use.resource, *use.outputVersion) << ";\n";
+                }
+            }
+        }
+
+        for (const auto& [resource, version] : versions) {
+            const auto& node = resources[resource];
+            stream << "    " << getVersionNode(resource, version) << " [shape=ellipse, label=\""
+                << escape(node.name) << " v" << version << "\\n" << toString(node.type) << ", "
+                << toString(node.lifetime) << '"';
+            if (node.lifetime == ResourceLifetime::Imported)
+                stream << ", style=filled, fillcolor=lightblue";
+            stream << "];\n";
+        }
+
+        if (const auto* layout = graph.getAliasingLayout()) {
+            for (uint32_t heap = 0; heap < layout->plan.heaps.size(); ++heap) {
+                stream << "    subgraph cluster_heap" << heap << " {\n";
+                stream << "        label=\"heap " << heap << ", " << layout->plan.heaps[heap].requirements.size
+                    << " bytes\";\n";
+                stream << "        style=dashed;\n";
+                for (const auto& [resource, version] : versions)
+                    if (heaps[resource] == heap)
+                        stream << "        " << getVersionNode(resource, version) << ";\n";
+                stream << "    }\n";
+            }
+        }
+
+        const auto& executionOrder = compiled.executionOrder;
+        for (const auto& split : compiled.splitBarriers)
+            stream << "    p" << executionOrder[split.signalPosition] << " -> p"
+                << executionOrder[split.waitPosition] << " [style=dashed, color=blue, label=\"event: "
+                << split.batch.imageBarriers.size() << " image, " << split.batch.bufferBarriers.size()
+                << " buffer\"];\n";
+
+        stream << "}\n";
+    }
+
+    void FrameGraphExporter::writeJson(std::ostream& stream) const {
+        const auto& compiled = graph.getCompiled();
+        const auto& resources = graph.getResources();
+        const auto& renderPasses = graph.getRenderPasses();
+
+        stream << "{\n  \"passes\": [";
+        for (uint32_t index = 0; index < renderPasses.size(); ++index) {
+            const auto& pass = renderPasses[index];
+            const auto position = positions[index];
+            const auto uses = getVersionUses(pass);
+
+            stream << (index == 0 ? "\n" : ",\n") << "    {\"index\": " << index
+                << ", \"name\": \"" << escape(pass.getName())
+                << "\", \"type\": \"" << toString(pass.getType())
+                << "\", \"culled\": " << (compiled.culled[index] ? "true" : "false")
+                << ", \"sideEffects\": " << (pass.hasSideEffects() ? "true" : "false")
+                << ", \"position\": ";
+            if (position)
+                stream << *position;
+            else
+                stream << "null";
+
+            stream << ", \"dependencies\": [";
+            for (std::size_t i = 0; i < compiled.dependencies[index].size(); ++i)
+                stream << (i == 0 ? "" : ", ") << compiled.dependencies[index][i];
+            stream << "], \"reads\": ";
+            writeJsonVersions(stream, uses, &VersionUse::inputVersion);
+            stream << ", \"writes\": ";
+            writeJsonVersions(stream, uses, &VersionUse::outputVersion);
+
+            if (position) {
+                const auto& batch = compiled.passBarriers[*position];
+                stream << ", \"barriers\": {\"memory\": " << batch.memoryBarriers.size()
+                    << ", \"buffer\": " << batch.bufferBarriers.size()
+                    << ", \"image\": " << batch.imageBarriers.size() << '}'
+                    << ", \"asyncCompute\": "
+                    << (*position >= compiled.asyncComputeBegin && *position < compiled.asyncComputeEnd
+                            ? "true"
+                            : "false")
+                    << ", \"continuesRendering\": " << (compiled.continuesRendering[*position] ? "true" : "false");
+            }
+
+            stream << ", \"recordTimeNs\": ";
+            writeJsonTime(stream, getRecordTime(position));
+            stream << ", \"gpuTimeNs\": ";
+            writeJsonTime(stream, getGpuTime(position));
+            stream << '}';
+        }
+
+        stream << "\n  ],\n  \"resources\": [";
+        for (uint32_t index = 0; index < resources.size(); ++index) {
+            const auto& resource = resources[index];
+            const auto& interval = compiled.resourceIntervals[index];
+
+            stream << (index == 0 ? "\n" : ",\n") << "    {\"index\": " << index
+                << ", \"name\": \"" << escape(resource.name)
+                << "\", \"type\": \"" << toString(resource.type)
+                << "\", \"lifetime\": \"" << toString(resource.lifetime)
+                << "\", \"versions\": " << resource.latestVersion + 1;
+            if (interval.isUsed())
+                stream << ", \"firstUse\": " << interval.firstUse << ", \"lastUse\": " << interval.lastUse;
+            else
+                stream << ", \"firstUse\": null, \"lastUse\": null";
+
+            stream << ", \"heap\": ";
+            if (heaps[index])
+                stream << *heaps[index];
+            else
+                stream << "null";
+            stream << '}';
+        }
+
+        stream << "\n  ],\n  \"splitBarriers\": [";
+        for (std::size_t i = 0; i < compiled.splitBarriers.size(); ++i) {
+            const auto& split = compiled.splitBarriers[i];
+            stream << (i == 0 ? "\n" : ",\n") << "    {\"signalPosition\": " << split.signalPosition
+                << ", \"waitPosition\": " << split.waitPosition
+                << ", \"memory\": " << split.batch.memoryBarriers.size()
+                << ", \"buffer\": " << split.batch.bufferBarriers.size()
+                << ", \"image\": " << split.batch.imageBarriers.size() << '}';
+        }
+
+        stream << "\n  ],\n  \"aliasing\": ";
+        if (const auto* layout = graph.getAliasingLayout()) {
+            const auto& plan = layout->plan;
+            stream << "{\"naiveSize\": " << plan.naiveSize << ", \"aliasedSize\": " << plan.aliasedSize
+                << ", \"heaps\": [";
+            for (std::size_t heap = 0; heap < plan.heaps.size(); ++heap) {
+                stream << (heap == 0 ? "\n" : ",\n") << "    {\"type\": \"" << toString(plan.heaps[heap].type)
+                    << "\", \"size\": " << plan.heaps[heap].requirements.size << ", \"resources\": [";
+
+                bool first = true;
+                for (std::size_t i = 0; i < layout->requests.size(); ++i) {
+                    if (plan.placements[i].heap != heap)
+                        continue;
+
+                    stream << (first ? "" : ", ") << "{\"resource\": " << layout->requests[i].resource
+                        << ", \"offset\": " << plan.placements[i].offset
+                        << ", \"size\": " << layout->requests[i].requirements.size << '}';
+                    first = false;
+                }
+                stream << "]}";
+            }
+            stream << "\n  ]}";
+        } else {
+            stream << "null";
+        }
+
+        stream << "\n}\n";
+    }
+}
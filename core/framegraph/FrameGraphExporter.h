@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace Vixen {
+    class FrameGraph;
+
+    /**
+     * Writes a compiled frame graph, including its culled passes, resource versions, barriers and aliased memory, as
+     * GraphViz DOT or JSON for offline inspection. Passes are annotated with the CPU time they took to record once the
+     * graph has been executed, and with their GPU time when it is known.
+     */
+    class FrameGraphExporter final {
+        const FrameGraph& graph;
+
+        /**
+         * Per position in the execution order, the GPU time of the pass, if measured.
+         */
+        std::vector<std::optional<std::chrono::nanoseconds>> gpuTimes;
+
+        /**
+         * Per render pass, its position in the execution order, or no value when it was culled.
+         */
+        std::vector<std::optional<uint32_t>> positions;
+
+        /**
+         * Per resource, the heap it was placed into when it shares memory with other resources.
+         */
+        std::vector<std::optional<uint32_t>> heaps;
+
+        [[nodiscard]] std::optional<std::chrono::nanoseconds> getRecordTime(std::optional<uint32_t> position) const;
+
+        [[nodiscard]] std::optional<std::chrono::nanoseconds> getGpuTime(std::optional<uint32_t> position) const;
+
+    public:
+        /**
+         * @param graph A compiled graph, which must outlive the exporter.
+         * @param gpuTimes Per position in the execution order, the GPU time of the pass if it is known.
+         */
+        explicit FrameGraphExporter(
+            const FrameGraph& graph,
+            std::vector<std::optional<std::chrono::nanoseconds>> gpuTimes = {}
+        );
+
+        void writeGraphViz(std::ostream& stream) const;
+
+        void writeJson(std::ostream& stream) const;
+    };
+}
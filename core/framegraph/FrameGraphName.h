@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Vixen {
+    /**
+     * The name of a frame graph pass or resource along with its hash, which the builder indexes names by. A name
+     * declared constexpr, such as one kept in a static table of pass names, is hashed at compile time, so graphs
+     * built from it every frame never hash it again.
+     */
+    class FrameGraphName {
+        std::string_view name;
+
+        uint64_t hash;
+
+        static constexpr uint64_t hashName(const std::string_view name) noexcept {
+            uint64_t hash = 14695981039346656037ull;
+            for (const auto character : name) {
+                hash ^= static_cast<unsigned char>(character);
+                hash *= 1099511628211ull;
+            }
+
+            return hash;
+        }
+
+    public:
+        constexpr FrameGraphName(const char* name) : FrameGraphName(std::string_view{name}) {}
+
+        constexpr FrameGraphName(const std::string_view name) : name(name), hash(hashName(name)) {}
+
+        /**
+         * The name only refers to the string, which must outlive it.
+         */
+        FrameGraphName(const std::string& name) : FrameGraphName(std::string_view{name}) {}
+
+        [[nodiscard]] constexpr std::string_view getName() const noexcept {
+            return name;
+        }
+
+        [[nodiscard]] constexpr uint64_t getHash() const noexcept {
+            return hash;
+        }
+    };
+}
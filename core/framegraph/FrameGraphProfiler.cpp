@@ -0,0 +1,172 @@
+#include "FrameGraphProfiler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "FrameGraph.h"
+#include "RenderingDeviceDriver.h"
+#include "command/QueryPool.h"
+#include "error/CantCreateError.h"
+
+namespace Vixen {
+    FrameGraphProfiler::FrameGraphProfiler(
+        RenderingDeviceDriver& driver,
+        const uint32_t framesInFlight,
+        const uint32_t queriesPerFrame,
+        const uint32_t sampleCount
+    ) : driver(driver),
+        queriesPerFrame(queriesPerFrame),
+        sampleCount(std::max(sampleCount, 1u)) {
+        try {
+            setFramesInFlight(framesInFlight);
+        } catch (...) {
+            for (const auto& frame : frames)
+                driver.destroyQueryPool(frame.queryPool);
+
+            throw;
+        }
+    }
+
+    FrameGraphProfiler::~FrameGraphProfiler() {
+        for (const auto& frame : frames)
+            driver.destroyQueryPool(frame.queryPool);
+    }
+
+    void FrameGraphProfiler::beginFrame(const uint32_t frameIndex) {
+        this->frameIndex = frameIndex % static_cast<uint32_t>(frames.size());
+
+        auto& frame = frames[this->frameIndex];
+        frame.usedQueries = 0;
+        frame.passes.clear();
+    }
+
+    void FrameGraphProfiler::setFramesInFlight(const uint32_t count) {
+        while (frames.size() > count) {
+            driver.destroyQueryPool(frames.back().queryPool);
+            frames.pop_back();
+        }
+
+        frames.reserve(count);
+        while (frames.size() < count) {
+            const auto queryPool = driver.createQueryPool(queriesPerFrame);
+            if (!queryPool)
+                throw CantCreateError("Failed to create frame graph profiler query pool");
+
+            frames.push_back({
+                .queryPool = queryPool.value(),
+                .usedQueries = 0,
+                .passes = {}
+            });
+        }
+
+        frameIndex = 0;
+    }
+
+    void FrameGraphProfiler::resolveFrame(const uint32_t frameIndex) {
+        auto& frame = frames[frameIndex % frames.size()];
+        if (frame.usedQueries == 0)
+            return;
+
+        const auto timestamps = driver.getQueryPoolResults(frame.queryPool, 0, frame.usedQueries);
+        if (!timestamps)
+            throw std::runtime_error("Failed to read frame graph profiler timestamps");
+
+        for (const auto& [nameHash, query] : frame.passes) {
+            const auto& begin = (*timestamps)[query];
+            const auto& end = (*timestamps)[query + 1];
+            if (!begin || !end || *end < *begin)
+                continue;
+
+            const std::chrono::nanoseconds time{*end - *begin};
+            auto& times = passTimes.at(nameHash);
+            if (times.sampleCount == sampleCount)
+                times.total -= times.samples[times.nextSample];
+            else
+                ++times.sampleCount;
+
+            times.samples[times.nextSample] = time;
+            times.total += time;
+            times.nextSample = (times.nextSample + 1) % sampleCount;
+        }
+
+        frame.usedQueries = 0;
+        frame.passes.clear();
+    }
+
+    std::optional<uint32_t> FrameGraphProfiler::addGraph(const FrameGraph& graph) {
+        auto& frame = frames[frameIndex];
+        const auto& executionOrder = graph.getCompiled().executionOrder;
+        const auto queryCount = static_cast<uint32_t>(executionOrder.size() * 2);
+        if (queryCount > queriesPerFrame - frame.usedQueries)
+            return std::nullopt;
+
+        const auto first = frame.usedQueries;
+        for (uint32_t position = 0; position < executionOrder.size(); ++position) {
+            const auto& pass = graph.getRenderPasses()[executionOrder[position]];
+            if (!passTimes.contains(pass.getNameHash())) {
+                passTimes.emplace(
+                    pass.getNameHash(),
+                    PassTimes{
+                        .name = std::string{pass.getName()},
+                        .samples = std::vector<std::chrono::nanoseconds>(sampleCount),
+                        .nextSample = 0,
+                        .sampleCount = 0,
+                        .total = {}
+                    }
+                );
+            }
+
+            frame.passes.push_back({
+                .nameHash = pass.getNameHash(),
+                .query = first + position * 2
+            });
+        }
+
+        frame.usedQueries += queryCount;
+
+        return first;
+    }
+
+    QueryPool* FrameGraphProfiler::getQueryPool() const noexcept {
+        return frames[frameIndex].queryPool;
+    }
+
+    std::optional<std::chrono::nanoseconds> FrameGraphProfiler::getGpuTime(const uint64_t nameHash) const {
+        const auto times = passTimes.find(nameHash);
+        if (times == passTimes.end() || times->second.sampleCount == 0)
+            return std::nullopt;
+
+        return times->second.total / times->second.sampleCount;
+    }
+
+    std::optional<std::chrono::nanoseconds> FrameGraphProfiler::getGpuTime(const FrameGraphName name) const {
+        return getGpuTime(name.getHash());
+    }
+
+    std::vector<std::optional<std::chrono::nanoseconds>> FrameGraphProfiler::getGpuTimes(
+        const FrameGraph& graph
+    ) const {
+        std::vector<std::optional<std::chrono::nanoseconds>> gpuTimes;
+        for (const auto pass : graph.getCompiled().executionOrder)
+            gpuTimes.push_back(getGpuTime(graph.getRenderPasses()[pass].getNameHash()));
+
+        return gpuTimes;
+    }
+
+    std::vector<FrameGraphProfiler::PassTime> FrameGraphProfiler::getPassTimes() const {
+        std::vector<PassTime> times;
+        for (const auto& [nameHash, passTime] : passTimes) {
+            if (passTime.sampleCount == 0)
+                continue;
+
+            const auto latest = (passTime.nextSample + sampleCount - 1) % sampleCount;
+            times.push_back({
+                .name = passTime.name,
+                .average = passTime.total / passTime.sampleCount,
+                .latest = passTime.samples[latest]
+            });
+        }
+
+        return times;
+    }
+}
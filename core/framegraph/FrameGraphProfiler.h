@@ -0,0 +1,142 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "FrameGraphName.h"
+
+namespace Vixen {
+    class FrameGraph;
+    struct QueryPool;
+    class RenderingDeviceDriver;
+
+    /**
+     * Measures the GPU time of frame graph passes with timestamps written before and after each of them. Every frame
+     * in flight has its own query pool, which is read back once the GPU has finished the frame, and the times of a
+     * pass are averaged over the last frames it was measured in, keyed by the name of the pass.
+     */
+    class FrameGraphProfiler final {
+        struct MeasuredPass {
+            uint64_t nameHash;
+
+            /**
+             * The first of the two queries written before and after the pass.
+             */
+            uint32_t query;
+        };
+
+        struct Frame {
+            QueryPool* queryPool;
+
+            uint32_t usedQueries;
+
+            std::vector<MeasuredPass> passes;
+        };
+
+        struct PassTimes {
+            std::string name;
+
+            /**
+             * The most recent times, which the next one overwrites the oldest of.
+             */
+            std::vector<std::chrono::nanoseconds> samples;
+
+            uint32_t nextSample;
+
+            uint32_t sampleCount;
+
+            std::chrono::nanoseconds total;
+        };
+
+        RenderingDeviceDriver& driver;
+
+        uint32_t queriesPerFrame;
+
+        uint32_t sampleCount;
+
+        uint32_t frameIndex = 0;
+
+        std::vector<Frame> frames;
+
+        std::unordered_map<uint64_t, PassTimes> passTimes;
+
+    public:
+        struct PassTime {
+            std::string_view name;
+
+            std::chrono::nanoseconds average;
+
+            std::chrono::nanoseconds latest;
+        };
+
+        /**
+         * @param queriesPerFrame The number of timestamps a frame can write, two for every pass executed in it.
+         * @param sampleCount The number of frames the times of a pass are averaged over.
+         */
+        FrameGraphProfiler(
+            RenderingDeviceDriver& driver,
+            uint32_t framesInFlight,
+            uint32_t queriesPerFrame = 2048,
+            uint32_t sampleCount = 60
+        );
+
+        FrameGraphProfiler(const FrameGraphProfiler& other) = delete;
+
+        FrameGraphProfiler(FrameGraphProfiler&& other) noexcept = delete;
+
+        FrameGraphProfiler& operator=(const FrameGraphProfiler& other) = delete;
+
+        FrameGraphProfiler& operator=(FrameGraphProfiler&& other) noexcept = delete;
+
+        ~FrameGraphProfiler();
+
+        /**
+         * Switches to the query pool of the frame. The frame must have been resolved since the GPU last finished it.
+         */
+        void beginFrame(uint32_t frameIndex);
+
+        /**
+         * Creates or destroys query pools so there is one for each frame in flight, keeping the times measured so
+         * far. Every frame must have been resolved, and beginFrame must be called again before graphs are added.
+         */
+        void setFramesInFlight(uint32_t count);
+
+        /**
+         * Reads back the timestamps written by the passes of the frame and adds their times to the averages. The GPU
+         * must have finished the frame.
+         */
+        void resolveFrame(uint32_t frameIndex);
+
+        /**
+         * Reserves the timestamps of every pass in the compiled graph's execution order, returning the first of them,
+         * or nullopt once the current frame has run out of queries.
+         */
+        std::optional<uint32_t> addGraph(const FrameGraph& graph);
+
+        [[nodiscard]] QueryPool* getQueryPool() const noexcept;
+
+        /**
+         * The average GPU time of the passes with the name, or nullopt until one has been measured.
+         */
+        [[nodiscard]] std::optional<std::chrono::nanoseconds> getGpuTime(uint64_t nameHash) const;
+
+        [[nodiscard]] std::optional<std::chrono::nanoseconds> getGpuTime(FrameGraphName name) const;
+
+        /**
+         * Per position in the compiled graph's execution order, the average GPU time of the pass, as taken by the
+         * FrameGraphExporter.
+         */
+        [[nodiscard]] std::vector<std::optional<std::chrono::nanoseconds>> getGpuTimes(const FrameGraph& graph) const;
+
+        /**
+         * The average and latest GPU time of every pass measured so far. The names are valid until the profiler is
+         * destroyed.
+         */
+        [[nodiscard]] std::vector<PassTime> getPassTimes() const;
+    };
+}
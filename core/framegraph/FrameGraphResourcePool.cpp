@@ -0,0 +1,399 @@
+#include "FrameGraphResourcePool.h"
+
+#include <algorithm>
+#include <functional>
+#include <ranges>
+#include <unordered_set>
+#include <utility>
+
+#include "MemoryAllocation.h"
+#include "RenderingDeviceDriver.h"
+#include "buffer/Buffer.h"
+#include "command/Event.h"
+#include "image/Image.h"
+
+namespace Vixen {
+    namespace {
+        template <typename T>
+        void hashCombine(std::size_t& seed, const T& value) {
+            seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        }
+
+        template <typename Cache, typename Predicate, typename Destroy>
+        void evict(Cache& cache, Predicate&& shouldEvict, Destroy&& destroy) {
+            for (auto it = cache.begin(); it != cache.end();) {
+                auto& entries = it->second;
+                std::erase_if(
+                    entries,
+                    [&](const auto& entry) {
+                        if (!shouldEvict(it->first, entry))
+                            return false;
+
+                        destroy(entry.object);
+                        return true;
+                    }
+                );
+
+                if (entries.empty())
+                    it = cache.erase(it);
+                else
+                    ++it;
+            }
+        }
+    }
+
+    std::size_t FrameGraphResourcePool::KeyHash::operator()(
+        const ImageResourceDescription& description
+    ) const noexcept {
+        const auto& format = description.format;
+        const auto& view = description.view;
+
+        std::size_t seed = 0;
+        hashCombine(seed, format.format);
+        hashCombine(seed, format.width);
+        hashCombine(seed, format.height);
+        hashCombine(seed, format.depth);
+        hashCombine(seed, format.layerCount);
+        hashCombine(seed, format.mipmapCount);
+        hashCombine(seed, format.type);
+        hashCombine(seed, format.samples);
+        hashCombine(seed, format.usage.value());
+        hashCombine(seed, view.format);
+        hashCombine(seed, view.swizzleRed);
+        hashCombine(seed, view.swizzleGreen);
+        hashCombine(seed, view.swizzleBlue);
+        hashCombine(seed, view.swizzleAlpha);
+
+        return seed;
+    }
+
+    std::size_t FrameGraphResourcePool::KeyHash::operator()(const BufferFormat& format) const noexcept {
+        std::size_t seed = 0;
+        hashCombine(seed, format.count);
+        hashCombine(seed, format.stride);
+        hashCombine(seed, format.usage.value());
+
+        return seed;
+    }
+
+    std::size_t FrameGraphResourcePool::KeyHash::operator()(const MemoryRequirements& requirements) const noexcept {
+        std::size_t seed = 0;
+        hashCombine(seed, requirements.size);
+        hashCombine(seed, requirements.alignment);
+        hashCombine(seed, requirements.memoryTypeBits);
+
+        return seed;
+    }
+
+    std::size_t FrameGraphResourcePool::KeyHash::operator()(const AliasedImageKey& key) const noexcept {
+        std::size_t seed = (*this)(key.description);
+        hashCombine(seed, key.heap);
+        hashCombine(seed, key.offset);
+
+        return seed;
+    }
+
+    std::size_t FrameGraphResourcePool::KeyHash::operator()(const AliasedBufferKey& key) const noexcept {
+        std::size_t seed = (*this)(key.format);
+        hashCombine(seed, key.heap);
+        hashCombine(seed, key.offset);
+
+        return seed;
+    }
+
+    template <typename Key, typename Object>
+    Object* FrameGraphResourcePool::take(Cache<Key, Object>& cache, const Key& key) {
+        const auto it = cache.find(key);
+        if (it == cache.end())
+            return nullptr;
+
+        auto& entries = it->second;
+        const auto entry = std::ranges::find_if(
+            entries,
+            [this](const Entry<Object>& candidate) {
+                return frame >= candidate.releasedFrame + framesInFlight;
+            }
+        );
+        if (entry == entries.end())
+            return nullptr;
+
+        Object* object = entry->object;
+        entries.erase(entry);
+
+        return object;
+    }
+
+    template <typename Key, typename Object>
+    void FrameGraphResourcePool::give(Cache<Key, Object>& cache, const Key& key, Object* object) {
+        cache[key].push_back({
+            .object = object,
+            .releasedFrame = frame
+        });
+    }
+
+    FrameGraphResourcePool::FrameGraphResourcePool(
+        RenderingDeviceDriver& driver,
+        const uint32_t framesInFlight,
+        const uint32_t evictionFrames
+    ) : driver(driver),
+        framesInFlight(framesInFlight),
+        evictionFrames(evictionFrames) {}
+
+    FrameGraphResourcePool::~FrameGraphResourcePool() {
+        for (const auto& entries : aliasedImages | std::views::values)
+            for (const auto& entry : entries)
+                driver.destroyImage(entry.object);
+
+        for (const auto& entries : aliasedBuffers | std::views::values)
+            for (const auto& entry : entries)
+                driver.destroyBuffer(entry.object);
+
+        for (const auto& entries : images | std::views::values)
+            for (const auto& entry : entries)
+                driver.destroyImage(entry.object);
+
+        for (const auto& entries : buffers | std::views::values)
+            for (const auto& entry : entries)
+                driver.destroyBuffer(entry.object);
+
+        for (const auto& entries : heaps | std::views::values)
+            for (const auto& entry : entries)
+                driver.freeMemory(entry.object);
+
+        for (std::size_t i = firstEvent; i < events.size(); ++i)
+            driver.destroyEvent(events[i].object);
+
+        for (const auto& history : histories | std::views::values)
+            for (auto* image : history.images)
+                driver.destroyImage(image);
+    }
+
+    void FrameGraphResourcePool::beginFrame() {
+        ++frame;
+
+        std::erase_if(
+            histories,
+            [this](const auto& entry) {
+                const auto& history = entry.second;
+                if (frame < history.usedFrame + evictionFrames)
+                    return false;
+
+                for (auto* image : history.images)
+                    give(images, history.description, image);
+
+                return true;
+            }
+        );
+
+        const uint64_t age = static_cast<uint64_t>(framesInFlight) + evictionFrames;
+        const auto expired = [this, age](const auto&, const auto& entry) {
+            return frame >= entry.releasedFrame + age;
+        };
+        const auto destroyImage = [this](Image* image) { driver.destroyImage(image); };
+        const auto destroyBuffer = [this](Buffer* buffer) { driver.destroyBuffer(buffer); };
+
+        evict(aliasedImages, expired, destroyImage);
+        evict(aliasedBuffers, expired, destroyBuffer);
+        evict(images, expired, destroyImage);
+        evict(buffers, expired, destroyBuffer);
+
+        for (; firstEvent < events.size() && expired(nullptr, events[firstEvent]); ++firstEvent)
+            driver.destroyEvent(events[firstEvent].object);
+
+        std::unordered_set<MemoryAllocation*> freedHeaps;
+        evict(
+            heaps,
+            expired,
+            [&](MemoryAllocation* heap) {
+                freedHeaps.insert(heap);
+                driver.freeMemory(heap);
+            }
+        );
+
+        if (freedHeaps.empty())
+            return;
+
+        // Resources placed in a freed heap are unusable, however recently they were released.
+        const auto inFreedHeap = [&freedHeaps](const auto& key, const auto&) {
+            return freedHeaps.contains(key.heap);
+        };
+        evict(aliasedImages, inFreedHeap, destroyImage);
+        evict(aliasedBuffers, inFreedHeap, destroyBuffer);
+    }
+
+    void FrameGraphResourcePool::setFramesInFlight(const uint32_t count) noexcept {
+        framesInFlight = count;
+    }
+
+    auto FrameGraphResourcePool::acquireImage(
+        const ImageResourceDescription& description
+    ) -> std::expected<Image*, Error> {
+        if (auto* image = take(images, description))
+            return image;
+
+        return driver.createImage(description.format, description.view);
+    }
+
+    auto FrameGraphResourcePool::acquireBuffer(
+        const BufferFormat& format
+    ) -> std::expected<Buffer*, Error> {
+        if (auto* buffer = take(buffers, format))
+            return buffer;
+
+        return driver.createBuffer(format.usage, format.count, format.stride);
+    }
+
+    auto FrameGraphResourcePool::acquireMemory(
+        const MemoryRequirements& requirements
+    ) -> std::expected<MemoryAllocation*, Error> {
+        if (auto* heap = take(heaps, requirements))
+            return heap;
+
+        return driver.allocateMemory(requirements);
+    }
+
+    auto FrameGraphResourcePool::acquireAliasedImage(
+        const ImageResourceDescription& description,
+        MemoryAllocation* heap,
+        const uint64_t offset
+    ) -> std::expected<Image*, Error> {
+        if (auto* image = take(aliasedImages, AliasedImageKey{description, heap, offset}))
+            return image;
+
+        return driver.createAliasedImage(description.format, description.view, heap, offset);
+    }
+
+    auto FrameGraphResourcePool::acquireAliasedBuffer(
+        const BufferFormat& format,
+        MemoryAllocation* heap,
+        const uint64_t offset
+    ) -> std::expected<Buffer*, Error> {
+        if (auto* buffer = take(aliasedBuffers, AliasedBufferKey{format, heap, offset}))
+            return buffer;
+
+        return driver.createAliasedBuffer(format.usage, format.count, format.stride, heap, offset);
+    }
+
+    auto FrameGraphResourcePool::acquireEvent() -> std::expected<Event*, Error> {
+        if (firstEvent == events.size() || frame < events[firstEvent].releasedFrame + framesInFlight)
+            return driver.createEvent();
+
+        return events[firstEvent++].object;
+    }
+
+    auto FrameGraphResourcePool::acquireHistory(
+        const uint64_t key,
+        const ImageResourceDescription& description
+    ) -> std::expected<HistoryImages, Error> {
+        if (const auto it = histories.find(key); it != histories.end()) {
+            auto& history = it->second;
+
+            if (history.description == description) {
+                if (history.usedFrame != frame) {
+                    std::swap(history.images[0], history.images[1]);
+                    history.usedFrame = frame;
+                }
+
+                return HistoryImages{
+                    .current = history.images[0],
+                    .previous = history.images[1],
+                    .valid = history.createdFrame != frame
+                };
+            }
+
+            for (auto* image : history.images)
+                give(images, history.description, image);
+
+            histories.erase(it);
+        }
+
+        const auto current = acquireImage(description);
+        if (!current)
+            return std::unexpected(current.error());
+
+        const auto previous = acquireImage(description);
+        if (!previous) {
+            give(images, description, current.value());
+            return std::unexpected(previous.error());
+        }
+
+        histories.emplace(
+            key,
+            History{
+                .description = description,
+                .images = {current.value(), previous.value()},
+                .createdFrame = frame,
+                .usedFrame = frame
+            }
+        );
+
+        return HistoryImages{
+            .current = current.value(),
+            .previous = previous.value(),
+            .valid = false
+        };
+    }
+
+    void FrameGraphResourcePool::releaseImage(
+        const ImageResourceDescription& description,
+        Image* image
+    ) {
+        give(images, description, image);
+    }
+
+    void FrameGraphResourcePool::releaseBuffer(
+        const BufferFormat& format,
+        Buffer* buffer
+    ) {
+        give(buffers, format, buffer);
+    }
+
+    void FrameGraphResourcePool::releaseMemory(
+        const MemoryRequirements& requirements,
+        MemoryAllocation* heap
+    ) {
+        give(heaps, requirements, heap);
+    }
+
+    void FrameGraphResourcePool::releaseAliasedImage(
+        const ImageResourceDescription& description,
+        MemoryAllocation* heap,
+        const uint64_t offset,
+        Image* image
+    ) {
+        give(aliasedImages, AliasedImageKey{description, heap, offset}, image);
+    }
+
+    void FrameGraphResourcePool::releaseAliasedBuffer(
+        const BufferFormat& format,
+        MemoryAllocation* heap,
+        const uint64_t offset,
+        Buffer* buffer
+    ) {
+        give(aliasedBuffers, AliasedBufferKey{format, heap, offset}, buffer);
+    }
+
+    void FrameGraphResourcePool::releaseEvent(
+        Event* event
+    ) {
+        // The entries taken from the front are dropped once they make up half of the queue, which keeps the storage
+        // for the next frames and costs constant time per event on average.
+        if (firstEvent * 2 >= events.size()) {
+            events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(firstEvent));
+            firstEvent = 0;
+        }
+
+        events.push_back({
+            .object = event,
+            .releasedFrame = frame
+        });
+    }
+
+    RenderingDeviceDriver& FrameGraphResourcePool::getDriver() const noexcept {
+        return driver;
+    }
+
+    uint64_t FrameGraphResourcePool::getFrame() const noexcept {
+        return frame;
+    }
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <unordered_map>
+#include <vector>
+
+#include "MemoryRequirements.h"
+#include "Node.h"
+
+namespace Vixen {
+    class Buffer;
+    struct Event;
+    struct Image;
+    struct MemoryAllocation;
+    class RenderingDeviceDriver;
+    enum class Error;
+
+    /**
+     * Keeps the physical resources of frame graphs alive across frames, so that a graph rebuilt every frame with the
+     * same resources gets back the images, buffers and heaps of an earlier frame instead of creating new ones.
+     * Released objects are only handed out again once every frame that may still be using them on the GPU has
+     * completed, and are destroyed once they have gone unused for a number of frames.
+     */
+    class FrameGraphResourcePool final {
+    public:
+        static constexpr uint32_t DefaultEvictionFrames = 8;
+
+        /**
+         * The two images of a history, which trade places every frame.
+         */
+        struct HistoryImages {
+            /**
+             * The image to write this frame.
+             */
+            Image* current;
+
+            /**
+             * The image written the last frame the history was used in.
+             */
+            Image* previous;
+
+            /**
+             * False when the history was created this frame, in which case neither image holds anything yet.
+             */
+            bool valid;
+        };
+
+    private:
+        struct History {
+            ImageResourceDescription description;
+
+            std::array<Image*, 2> images;
+
+            uint64_t createdFrame;
+
+            uint64_t usedFrame;
+        };
+        struct AliasedImageKey {
+            ImageResourceDescription description;
+
+            MemoryAllocation* heap;
+
+            uint64_t offset;
+
+            bool operator==(const AliasedImageKey& other) const = default;
+        };
+
+        struct AliasedBufferKey {
+            BufferFormat format;
+
+            MemoryAllocation* heap;
+
+            uint64_t offset;
+
+            bool operator==(const AliasedBufferKey& other) const = default;
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const ImageResourceDescription& description) const noexcept;
+
+            std::size_t operator()(const BufferFormat& format) const noexcept;
+
+            std::size_t operator()(const MemoryRequirements& requirements) const noexcept;
+
+            std::size_t operator()(const AliasedImageKey& key) const noexcept;
+
+            std::size_t operator()(const AliasedBufferKey& key) const noexcept;
+        };
+
+        template <typename Object>
+        struct Entry {
+            Object* object;
+
+            uint64_t releasedFrame;
+        };
+
+        template <typename Key, typename Object>
+        using Cache = std::unordered_map<Key, std::vector<Entry<Object>>, KeyHash>;
+
+        RenderingDeviceDriver& driver;
+
+        uint32_t framesInFlight;
+
+        uint32_t evictionFrames;
+
+        uint64_t frame = 0;
+
+        Cache<ImageResourceDescription, Image> images;
+
+        Cache<BufferFormat, Buffer> buffers;
+
+        Cache<MemoryRequirements, MemoryAllocation> heaps;
+
+        Cache<AliasedImageKey, Image> aliasedImages;
+
+        Cache<AliasedBufferKey, Buffer> aliasedBuffers;
+
+        /**
+         * Released events in the order they were released, so those that can be handed out again or have gone unused
+         * long enough to be destroyed are always at the front, starting at firstEvent.
+         */
+        std::vector<Entry<Event>> events;
+
+        std::size_t firstEvent = 0;
+
+        std::unordered_map<uint64_t, History> histories;
+
+        template <typename Key, typename Object>
+        Object* take(Cache<Key, Object>& cache, const Key& key);
+
+        template <typename Key, typename Object>
+        void give(Cache<Key, Object>& cache, const Key& key, Object* object);
+
+    public:
+        /**
+         * @param framesInFlight The number of frames the GPU may be working on at once. An object released during a
+         * frame is not handed out again until this many further frames have begun.
+         * @param evictionFrames The number of frames an object may sit unused in the pool, after it is safe to
+         * reuse, before it is destroyed.
+         */
+        FrameGraphResourcePool(
+            RenderingDeviceDriver& driver,
+            uint32_t framesInFlight,
+            uint32_t evictionFrames = DefaultEvictionFrames
+        );
+
+        FrameGraphResourcePool(const FrameGraphResourcePool& other) = delete;
+
+        FrameGraphResourcePool(FrameGraphResourcePool&& other) noexcept = delete;
+
+        FrameGraphResourcePool& operator=(const FrameGraphResourcePool& other) = delete;
+
+        FrameGraphResourcePool& operator=(FrameGraphResourcePool&& other) noexcept = delete;
+
+        /**
+         * Destroys every pooled object. Objects still held by a frame graph are not owned by the pool, so every graph
+         * executed with this pool must be destroyed first, and the GPU must be idle.
+         */
+        ~FrameGraphResourcePool();
+
+        /**
+         * Advances to the next frame and destroys objects that have gone unused for too long. Must be called once
+         * per frame, after waiting for the frame that is about to be reused, and never when a frame is only flushed
+         * halfway, since histories swap once per frame.
+         */
+        void beginFrame();
+
+        void setFramesInFlight(uint32_t count) noexcept;
+
+        auto acquireImage(
+            const ImageResourceDescription& description
+        ) -> std::expected<Image*, Error>;
+
+        auto acquireBuffer(
+            const BufferFormat& format
+        ) -> std::expected<Buffer*, Error>;
+
+        auto acquireMemory(
+            const MemoryRequirements& requirements
+        ) -> std::expected<MemoryAllocation*, Error>;
+
+        auto acquireAliasedImage(
+            const ImageResourceDescription& description,
+            MemoryAllocation* heap,
+            uint64_t offset
+        ) -> std::expected<Image*, Error>;
+
+        auto acquireAliasedBuffer(
+            const BufferFormat& format,
+            MemoryAllocation* heap,
+            uint64_t offset
+        ) -> std::expected<Buffer*, Error>;
+
+        auto acquireEvent() -> std::expected<Event*, Error>;
+
+        /**
+         * Returns the images of the history kept under the key, swapping them if they were last returned in an
+         * earlier frame, as counted by beginFrame. The history is created when first asked for, or created again when
+         * the description changes, and is released once it has gone unused as long as any other object.
+         */
+        auto acquireHistory(
+            uint64_t key,
+            const ImageResourceDescription& description
+        ) -> std::expected<HistoryImages, Error>;
+
+        void releaseImage(
+            const ImageResourceDescription& description,
+            Image* image
+        );
+
+        void releaseBuffer(
+            const BufferFormat& format,
+            Buffer* buffer
+        );
+
+        void releaseMemory(
+            const MemoryRequirements& requirements,
+            MemoryAllocation* heap
+        );
+
+        void releaseAliasedImage(
+            const ImageResourceDescription& description,
+            MemoryAllocation* heap,
+            uint64_t offset,
+            Image* image
+        );
+
+        void releaseAliasedBuffer(
+            const BufferFormat& format,
+            MemoryAllocation* heap,
+            uint64_t offset,
+            Buffer* buffer
+        );
+
+        /**
+         * Hands back an event, which must have been reset by the commands that last waited on it.
+         */
+        void releaseEvent(
+            Event* event
+        );
+
+        [[nodiscard]] RenderingDeviceDriver& getDriver() const noexcept;
+
+        [[nodiscard]] uint64_t getFrame() const noexcept;
+    };
+}
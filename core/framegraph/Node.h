@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <variant>
@@ -18,6 +19,8 @@ namespace Vixen {
         ImageFormat format;
 
         ImageView view;
+
+        bool operator==(const ImageResourceDescription& other) const = default;
     };
 
     using ResourceDescription = std::variant<ImageResourceDescription, BufferFormat>;
@@ -25,7 +28,7 @@ namespace Vixen {
     using ImportedResource = std::variant<std::monostate, Image*, Buffer*>;
 
     struct ResourceNode {
-        std::string name;
+        std::pmr::string name;
 
         ResourceType type;
 
@@ -0,0 +1,186 @@
+#include "ParallelPassRecorder.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "RenderingDeviceDriver.h"
+#include "command/CommandBuffer.h"
+#include "command/CommandBufferType.h"
+#include "command/CommandPool.h"
+#include "error/CantCreateError.h"
+
+namespace Vixen {
+    void ParallelPassRecorder::workerLoop(const uint32_t thread) {
+        uint64_t seenGeneration = 0;
+
+        while (true) {
+            std::unique_lock lock{mutex};
+            workAvailable.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping)
+                return;
+
+            seenGeneration = generation;
+            if (thread >= jobCount)
+                continue;
+
+            lock.unlock();
+            run(thread);
+            lock.lock();
+
+            if (--pendingWorkers == 0)
+                workFinished.notify_one();
+        }
+    }
+
+    void ParallelPassRecorder::run(const uint32_t thread) {
+        const auto& threadFrame = frames[frameIndex][thread];
+        CommandBuffer* commandBuffer = threadFrame.commandBuffers[threadFrame.used];
+
+        try {
+            if (!driver.beginCommandBuffer(commandBuffer))
+                throw std::runtime_error("Failed to begin secondary command buffer");
+
+            job.invoke(job.job, thread, commandBuffer);
+
+            driver.endCommandBuffer(commandBuffer);
+        } catch (...) {
+            errors[thread] = std::current_exception();
+        }
+    }
+
+    std::vector<ParallelPassRecorder::ThreadFrame> ParallelPassRecorder::createThreadFrames() {
+        std::vector<ThreadFrame> threads;
+        threads.reserve(threadCount);
+        for (uint32_t thread = 0; thread < threadCount; ++thread) {
+            const auto commandPool = driver.createCommandPool(queueFamily, CommandBufferType::Secondary);
+            if (!commandPool) {
+                destroyThreadFrames(threads);
+                throw CantCreateError("Failed to create recording thread command pool");
+            }
+
+            threads.push_back({
+                .commandPool = commandPool.value(),
+                .commandBuffers = {},
+                .used = 0
+            });
+        }
+
+        return threads;
+    }
+
+    void ParallelPassRecorder::destroyThreadFrames(const std::vector<ThreadFrame>& threads) {
+        for (const auto& [commandPool, commandBuffers, used] : threads) {
+            driver.destroyCommandPool(commandPool);
+            for (const auto commandBuffer : commandBuffers)
+                delete commandBuffer;
+        }
+    }
+
+    ParallelPassRecorder::ParallelPassRecorder(
+        RenderingDeviceDriver& driver,
+        const uint32_t queueFamily,
+        const uint32_t framesInFlight,
+        const uint32_t threadCount
+    ) : driver(driver),
+        queueFamily(queueFamily),
+        threadCount(std::max(threadCount, 1u)),
+        errors(this->threadCount) {
+        setFramesInFlight(framesInFlight);
+
+        workers.reserve(this->threadCount - 1);
+        for (uint32_t thread = 1; thread < this->threadCount; ++thread)
+            workers.emplace_back([this, thread] { workerLoop(thread); });
+    }
+
+    ParallelPassRecorder::~ParallelPassRecorder() {
+        {
+            std::scoped_lock lock{mutex};
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        workers.clear();
+
+        for (const auto& threads : frames)
+            destroyThreadFrames(threads);
+    }
+
+    void ParallelPassRecorder::beginFrame(const uint32_t frameIndex) {
+        this->frameIndex = frameIndex % static_cast<uint32_t>(frames.size());
+
+        for (auto& threadFrame : frames[this->frameIndex]) {
+            if (!driver.resetCommandPool(threadFrame.commandPool))
+                throw std::runtime_error("Failed to reset recording thread command pool");
+
+            threadFrame.used = 0;
+        }
+    }
+
+    void ParallelPassRecorder::setFramesInFlight(const uint32_t count) {
+        while (frames.size() > count) {
+            destroyThreadFrames(frames.back());
+            frames.pop_back();
+        }
+
+        frames.reserve(count);
+        while (frames.size() < count)
+            frames.push_back(createThreadFrames());
+
+        frameIndex = 0;
+    }
+
+    void ParallelPassRecorder::recordJob(
+        const std::span<CommandBuffer*> commandBuffers,
+        const JobReference job
+    ) {
+        const auto count = static_cast<uint32_t>(commandBuffers.size());
+        if (commandBuffers.size() > threadCount)
+            throw std::invalid_argument("Cannot record more command buffers than there are recording threads");
+
+        if (count == 0)
+            return;
+
+        // Command buffers are allocated up front on this thread, so no pool is touched by two threads at once
+        for (uint32_t thread = 0; thread < count; ++thread) {
+            auto& threadFrame = frames[frameIndex][thread];
+            if (threadFrame.used < threadFrame.commandBuffers.size())
+                continue;
+
+            const auto commandBuffer = driver.createCommandBuffer(threadFrame.commandPool);
+            if (!commandBuffer)
+                throw CantCreateError("Failed to create recording thread command buffer");
+
+            threadFrame.commandBuffers.push_back(commandBuffer.value());
+        }
+
+        {
+            std::scoped_lock lock{mutex};
+            this->job = job;
+            jobCount = count;
+            pendingWorkers = count - 1;
+            ++generation;
+        }
+        workAvailable.notify_all();
+
+        run(0);
+
+        {
+            std::unique_lock lock{mutex};
+            workFinished.wait(lock, [this] { return pendingWorkers == 0; });
+            this->job = {};
+        }
+
+        for (uint32_t thread = 0; thread < count; ++thread) {
+            auto& threadFrame = frames[frameIndex][thread];
+            commandBuffers[thread] = threadFrame.commandBuffers[threadFrame.used++];
+        }
+
+        for (auto& error : errors) {
+            if (error)
+                std::rethrow_exception(std::exchange(error, nullptr));
+        }
+    }
+
+    uint32_t ParallelPassRecorder::getThreadCount() const noexcept {
+        return threadCount;
+    }
+}
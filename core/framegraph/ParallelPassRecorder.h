@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Vixen {
+    struct CommandBuffer;
+    struct CommandPool;
+    class RenderingDeviceDriver;
+
+    /**
+     * A fixed set of recording threads, each with its own command pool per frame in flight, so that command pools are
+     * never shared between threads and are only reset once the frame that used them has completed. Every call to
+     * record during a frame takes fresh secondary command buffers from the pools, which grow as needed, so command
+     * buffers already handed out stay valid until the frame is next begun.
+     */
+    class ParallelPassRecorder final {
+        struct ThreadFrame {
+            CommandPool* commandPool;
+
+            std::vector<CommandBuffer*> commandBuffers;
+
+            /**
+             * The number of command buffers handed out since the frame began.
+             */
+            uint32_t used;
+        };
+
+        /**
+         * A reference to the job of a recording, which the caller keeps alive until every thread has run it, so
+         * handing it to the threads does not allocate.
+         */
+        struct JobReference {
+            const void* job;
+
+            void (*invoke)(const void* job, uint32_t index, CommandBuffer* commandBuffer);
+        };
+
+        RenderingDeviceDriver& driver;
+
+        uint32_t queueFamily;
+
+        uint32_t threadCount;
+
+        uint32_t frameIndex = 0;
+
+        /**
+         * Per frame in flight, the command pool and secondary command buffers of every thread.
+         */
+        std::vector<std::vector<ThreadFrame>> frames;
+
+        std::mutex mutex;
+
+        std::condition_variable workAvailable;
+
+        std::condition_variable workFinished;
+
+        JobReference job{};
+
+        uint32_t jobCount = 0;
+
+        uint64_t generation = 0;
+
+        uint32_t pendingWorkers = 0;
+
+        bool stopping = false;
+
+        std::vector<std::exception_ptr> errors;
+
+        std::vector<std::jthread> workers;
+
+        void workerLoop(uint32_t thread);
+
+        void run(uint32_t thread);
+
+        std::vector<ThreadFrame> createThreadFrames();
+
+        void destroyThreadFrames(const std::vector<ThreadFrame>& threads);
+
+        void recordJob(
+            std::span<CommandBuffer*> commandBuffers,
+            JobReference job
+        );
+
+    public:
+        /**
+         * @param queueFamily The queue family the secondary command buffers will be executed on.
+         * @param threadCount The number of threads recording concurrently, including the thread calling record.
+         */
+        ParallelPassRecorder(
+            RenderingDeviceDriver& driver,
+            uint32_t queueFamily,
+            uint32_t framesInFlight,
+            uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 1u)
+        );
+
+        ParallelPassRecorder(const ParallelPassRecorder& other) = delete;
+
+        ParallelPassRecorder(ParallelPassRecorder&& other) noexcept = delete;
+
+        ParallelPassRecorder& operator=(const ParallelPassRecorder& other) = delete;
+
+        ParallelPassRecorder& operator=(ParallelPassRecorder&& other) noexcept = delete;
+
+        ~ParallelPassRecorder();
+
+        /**
+         * Switches to the command pools of the frame and resets them. The GPU must have finished the last frame that
+         * used the same index.
+         */
+        void beginFrame(uint32_t frameIndex);
+
+        /**
+         * Creates or destroys the command pools of frames so there is one set for each frame in flight. The GPU must
+         * be idle, and beginFrame must be called again before recording.
+         */
+        void setFramesInFlight(uint32_t count);
+
+        /**
+         * Runs the job once for every command buffer slot, each on its own thread with a begun secondary command
+         * buffer, and writes the ended command buffers into their slots. They are not reused until the frame is next
+         * begun, so recording several times in a frame is allowed. The job for index zero runs on the calling thread.
+         * Exceptions thrown by any job are rethrown once every job has finished.
+         */
+        template <typename Job>
+            requires std::invocable<const Job&, uint32_t, CommandBuffer*>
+        void record(
+            const std::span<CommandBuffer*> commandBuffers,
+            const Job& job
+        ) {
+            recordJob(
+                commandBuffers,
+                {
+                    .job = &job,
+                    .invoke = [](const void* job, const uint32_t index, CommandBuffer* commandBuffer) {
+                        (*static_cast<const Job*>(job))(index, commandBuffer);
+                    }
+                }
+            );
+        }
+
+        [[nodiscard]] uint32_t getThreadCount() const noexcept;
+    };
+}
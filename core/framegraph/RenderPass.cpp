@@ -2,40 +2,52 @@
 
 namespace Vixen {
     RenderPass::RenderPass(
-        std::string name,
+        std::pmr::string name,
+        const uint64_t nameHash,
         const RenderPassType type,
-        std::vector<ResourceUsage> resourceUsages,
-        std::vector<RenderAttachment> colorAttachments,
+        std::pmr::vector<ResourceUsage> resourceUsages,
+        std::pmr::vector<RenderAttachment> colorAttachments,
         std::optional<RenderAttachment> depthStencilAttachment,
+        const bool sideEffects,
         ExecuteCallback executeCallback
     ) : name(std::move(name)),
+        nameHash(nameHash),
         type(type),
         resourceUsages(std::move(resourceUsages)),
         colorAttachments(std::move(colorAttachments)),
         depthStencilAttachment(std::move(depthStencilAttachment)),
+        sideEffects(sideEffects),
         executeCallback(std::move(executeCallback)) {}
 
     void RenderPass::execute(RenderPassContext& context) {
         executeCallback(context);
     }
 
-    const std::string& RenderPass::getName() const noexcept {
+    std::string_view RenderPass::getName() const noexcept {
         return name;
     }
 
+    uint64_t RenderPass::getNameHash() const noexcept {
+        return nameHash;
+    }
+
     RenderPassType RenderPass::getType() const noexcept {
         return type;
     }
 
-    const std::vector<ResourceUsage>& RenderPass::getResourceUsages() const noexcept {
+    const std::pmr::vector<ResourceUsage>& RenderPass::getResourceUsages() const noexcept {
         return resourceUsages;
     }
 
-    const std::vector<RenderAttachment>& RenderPass::getColorAttachments() const noexcept {
+    const std::pmr::vector<RenderAttachment>& RenderPass::getColorAttachments() const noexcept {
         return colorAttachments;
     }
 
     const std::optional<RenderAttachment>& RenderPass::getDepthStencilAttachment() const noexcept {
         return depthStencilAttachment;
     }
+
+    bool RenderPass::hasSideEffects() const noexcept {
+        return sideEffects;
+    }
 }
@@ -1,16 +1,19 @@
 #pragma once
 
-#include <algorithm>
 #include <functional>
 #include <limits>
+#include <memory_resource>
+#include <new>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "ClearValue.h"
+#include "FrameGraphName.h"
 #include "LoadAction.h"
 #include "Node.h"
 #include "RenderPassType.h"
@@ -29,29 +32,131 @@ namespace Vixen {
         ClearValue clearValue;
     };
 
+    /**
+     * Bookkeeping shared by the pass builders of one graph, which keeps declaring a usage constant time.
+     */
+    struct PassDeclarations {
+        /**
+         * Per resource, the scope of the pass that declared it last.
+         */
+        std::pmr::vector<uint32_t> scopes;
+
+        /**
+         * The resources advanced by the pass being built, at the version they had before, so a pass whose setup
+         * throws can be rolled back.
+         */
+        std::pmr::vector<ResourceId> advanced;
+
+        /**
+         * The scope of the pass being built. Scope zero is never used, so resources start out undeclared.
+         */
+        uint32_t scope = 0;
+    };
+
     class RenderPass {
     public:
-        using ExecuteCallback = std::move_only_function<void(RenderPassContext&)>;
+        /**
+         * A move-only callable like std::move_only_function, but whose captures are always placed in the memory
+         * resource the pass was built with, rather than on the global heap when they are too large to be stored
+         * inline.
+         */
+        class ExecuteCallback {
+            void* callable = nullptr;
+
+            void (*invoke)(void* callable, RenderPassContext& context) = nullptr;
+
+            void (*destroy)(void* callable, std::pmr::memory_resource* memoryResource) noexcept = nullptr;
+
+            std::pmr::memory_resource* memoryResource = nullptr;
+
+        public:
+            ExecuteCallback() = default;
+
+            template <typename Callable>
+            ExecuteCallback(
+                Callable&& callable,
+                std::pmr::memory_resource* memoryResource
+            ) : memoryResource(memoryResource) {
+                using StoredCallable = std::decay_t<Callable>;
+
+                void* memory = memoryResource->allocate(sizeof(StoredCallable), alignof(StoredCallable));
+                try {
+                    this->callable = ::new(memory) StoredCallable(std::forward<Callable>(callable));
+                } catch (...) {
+                    memoryResource->deallocate(memory, sizeof(StoredCallable), alignof(StoredCallable));
+                    throw;
+                }
+
+                invoke = [](void* stored, RenderPassContext& context) {
+                    (*static_cast<StoredCallable*>(stored))(context);
+                };
+                destroy = [](void* stored, std::pmr::memory_resource* resource) noexcept {
+                    static_cast<StoredCallable*>(stored)->~StoredCallable();
+                    resource->deallocate(stored, sizeof(StoredCallable), alignof(StoredCallable));
+                };
+            }
+
+            ExecuteCallback(const ExecuteCallback& other) = delete;
+
+            ExecuteCallback(ExecuteCallback&& other) noexcept
+                : callable(std::exchange(other.callable, nullptr)),
+                  invoke(std::exchange(other.invoke, nullptr)),
+                  destroy(std::exchange(other.destroy, nullptr)),
+                  memoryResource(std::exchange(other.memoryResource, nullptr)) {}
+
+            ExecuteCallback& operator=(const ExecuteCallback& other) = delete;
+
+            ExecuteCallback& operator=(ExecuteCallback&& other) noexcept {
+                if (this != &other) {
+                    reset();
+                    callable = std::exchange(other.callable, nullptr);
+                    invoke = std::exchange(other.invoke, nullptr);
+                    destroy = std::exchange(other.destroy, nullptr);
+                    memoryResource = std::exchange(other.memoryResource, nullptr);
+                }
+
+                return *this;
+            }
+
+            ~ExecuteCallback() {
+                reset();
+            }
+
+            void reset() noexcept {
+                if (callable)
+                    destroy(std::exchange(callable, nullptr), memoryResource);
+            }
+
+            void operator()(RenderPassContext& context) const {
+                invoke(callable, context);
+            }
+        };
 
     private:
-        std::string name;
+        std::pmr::string name;
+
+        uint64_t nameHash;
 
         RenderPassType type;
 
-        std::vector<ResourceUsage> resourceUsages;
+        std::pmr::vector<ResourceUsage> resourceUsages;
 
-        std::vector<RenderAttachment> colorAttachments;
+        std::pmr::vector<RenderAttachment> colorAttachments;
 
         std::optional<RenderAttachment> depthStencilAttachment;
 
+        bool sideEffects;
+
         ExecuteCallback executeCallback;
 
         RenderPass(
-            std::string name,
+            std::pmr::string name,
+            uint64_t nameHash,
             RenderPassType type,
-            std::vector<ResourceUsage> resourceUsages,
-            std::vector<RenderAttachment> colorAttachments,
+            std::pmr::vector<ResourceUsage> resourceUsages,
+            std::pmr::vector<RenderAttachment> colorAttachments,
             std::optional<RenderAttachment> depthStencilAttachment,
+            bool sideEffects,
             ExecuteCallback executeCallback
         );
 
@@ -68,52 +173,41 @@ namespace Vixen {
 
         void execute(RenderPassContext& context);
 
-        [[nodiscard]] const std::string& getName() const noexcept;
+        [[nodiscard]] std::string_view getName() const noexcept;
+
+        [[nodiscard]] uint64_t getNameHash() const noexcept;
 
         [[nodiscard]] RenderPassType getType() const noexcept;
 
-        [[nodiscard]] const std::vector<ResourceUsage>& getResourceUsages() const noexcept;
+        [[nodiscard]] const std::pmr::vector<ResourceUsage>& getResourceUsages() const noexcept;
 
-        [[nodiscard]] const std::vector<RenderAttachment>& getColorAttachments() const noexcept;
+        [[nodiscard]] const std::pmr::vector<RenderAttachment>& getColorAttachments() const noexcept;
 
         [[nodiscard]] const std::optional<RenderAttachment>& getDepthStencilAttachment() const noexcept;
 
+        [[nodiscard]] bool hasSideEffects() const noexcept;
+
         class Builder {
-            std::vector<ResourceNode>& resources;
+            std::pmr::vector<ResourceNode>& resources;
 
-            std::string name;
+            PassDeclarations& declarations;
+
+            std::pmr::string name;
+
+            uint64_t nameHash;
 
             RenderPassType type;
 
-            std::vector<ResourceUsage> resourceUsages;
+            std::pmr::vector<ResourceUsage> resourceUsages;
 
-            std::vector<RenderAttachment> colorAttachments;
+            std::pmr::vector<RenderAttachment> colorAttachments;
 
             std::optional<RenderAttachment> depthStencilAttachment;
 
-            void validateUnused(const ResourceId id) const {
-                const bool alreadyUsed = std::ranges::any_of(
-                    resourceUsages,
-                    [id](const ResourceUsage& usage) {
-                        return std::visit(
-                            [id](const auto& typedUsage) {
-                                return (typedUsage.input.isValid() && typedUsage.input.id.index == id.index) ||
-                                       (typedUsage.output.isValid() && typedUsage.output.id.index == id.index);
-                            },
-                            usage
-                        );
-                    }
-                );
-
-                if (alreadyUsed)
-                    throw std::logic_error{
-                        "Frame graph resource '" + resources[id.index].name +
-                        "' is declared more than once in pass '" + name + "'"
-                    };
-            }
+            bool sideEffects = false;
 
             template <typename Handle>
-            void validateCurrent(
+            void validateType(
                 const Handle handle,
                 const ResourceType expectedType
             ) const {
@@ -123,43 +217,188 @@ namespace Vixen {
                 if (handle.id.index >= resources.size())
                     throw std::out_of_range("Frame graph resource handle is out of range");
 
-                const auto& node = resources[handle.id.index];
-
-                if (node.type != expectedType)
+                if (resources[handle.id.index].type != expectedType)
                     throw std::invalid_argument("Frame graph resource type mismatch");
-
-                if (handle.id.version != node.latestVersion)
-                    throw std::invalid_argument("Stale frame graph resource handle");
             }
 
             template <typename Handle>
-            Handle advance(
+            void validateCurrent(
                 const Handle handle,
                 const ResourceType expectedType
-            ) {
-                validateCurrent(handle, expectedType);
-                validateUnused(handle.id);
+            ) const {
+                validateType(handle, expectedType);
 
-                auto& node = resources[handle.id.index];
+                if (handle.id.version != resources[handle.id.index].latestVersion)
+                    throw std::invalid_argument("Stale frame graph resource handle");
+            }
+
+            ResourceId nextVersion(const ResourceId id) {
+                auto& node = resources[id.index];
 
                 if (node.latestVersion == std::numeric_limits<uint32_t>::max())
                     throw std::overflow_error{"Frame graph resource version limit exceeded"};
 
+                declarations.advanced.push_back(id);
                 ++node.latestVersion;
 
-                return Handle{
+                return {
+                    .index = id.index,
+                    .version = node.latestVersion
+                };
+            }
+
+            [[nodiscard]] ImageSubresourceRange getFullSubresourceRange(const ImageHandle handle) const {
+                validateType(handle, ResourceType::Image);
+
+                const auto& format = std::get<ImageResourceDescription>(resources[handle.id.index].description).format;
+
+                return {
+                    .aspect = getImageAspects(format.format),
+                    .baseMipmap = 0,
+                    .mipmapCount = format.mipmapCount,
+                    .baseLayer = 0,
+                    .layerCount = format.layerCount
+                };
+            }
+
+            [[nodiscard]] uint64_t getWholeSize(const BufferHandle handle) const {
+                validateType(handle, ResourceType::Buffer);
+
+                return std::get<BufferFormat>(resources[handle.id.index].description).getSize();
+            }
+
+            /**
+             * Declares a usage of part of a resource, returning the version the pass reads it at, and advancing the
+             * resource when the pass writes it. A pass may declare a resource more than once as long as the parts do
+             * not overlap, such as a downsample reading one mipmap and writing the next. The pass then still produces
+             * a single version, and later declarations may name the resource by either the version it had before the
+             * pass or the one the pass produced.
+             */
+            template <typename Handle, typename Overlaps>
+            Handle declarePart(
+                const Handle handle,
+                const bool writes,
+                Overlaps&& overlaps
+            ) {
+                auto& node = resources[handle.id.index];
+
+                if (declarations.scopes[handle.id.index] != declarations.scope) {
+                    validateCurrent(handle, node.type);
+                    declarations.scopes[handle.id.index] = declarations.scope;
+
+                    if (writes)
+                        nextVersion(handle.id);
+
+                    return handle;
+                }
+
+                uint32_t version = node.latestVersion;
+                for (const auto& usage : resourceUsages) {
+                    const auto [input, output] = std::visit(
+                        [](const auto& typedUsage) {
+                            return std::pair{typedUsage.input.id, typedUsage.output.id};
+                        },
+                        usage
+                    );
+
+                    if ((input.isValid() ? input.index : output.index) != handle.id.index)
+                        continue;
+
+                    if (overlaps(usage))
+                        throw std::logic_error{
+                            "Frame graph resource '" + std::string{node.name} +
+                            "' is declared more than once in pass '" + std::string{name} +
+                            "' with overlapping ranges"
+                        };
+
+                    version = input.isValid() ? input.version : output.version - 1;
+                }
+
+                if (handle.id.version != version && handle.id.version != node.latestVersion)
+                    throw std::invalid_argument("Stale frame graph resource handle");
+
+                const Handle input{
                     .id = {
                         .index = handle.id.index,
-                        .version = node.latestVersion
+                        .version = version
                     }
                 };
+
+                if (writes && node.latestVersion == version)
+                    nextVersion(input.id);
+
+                return input;
+            }
+
+            ImageHandle declareImage(
+                const ImageHandle handle,
+                const ImageSubresourceRange& subresources,
+                const bool writes
+            ) {
+                validateType(handle, ResourceType::Image);
+
+                const auto& node = resources[handle.id.index];
+                const auto& format = std::get<ImageResourceDescription>(node.description).format;
+
+                if (subresources.mipmapCount == 0 || subresources.layerCount == 0 ||
+                    subresources.baseMipmap >= format.mipmapCount ||
+                    subresources.mipmapCount > format.mipmapCount - subresources.baseMipmap ||
+                    subresources.baseLayer >= format.layerCount ||
+                    subresources.layerCount > format.layerCount - subresources.baseLayer)
+                    throw std::out_of_range{
+                        "Subresources of frame graph image '" + std::string{node.name} + "' are out of range"
+                    };
+
+                return declarePart(handle, writes, [&subresources](const ResourceUsage& usage) {
+                    const auto& other = std::get<ImageResourceUsage>(usage).subresources;
+
+                    return other.baseMipmap < subresources.baseMipmap + subresources.mipmapCount &&
+                           subresources.baseMipmap < other.baseMipmap + other.mipmapCount &&
+                           other.baseLayer < subresources.baseLayer + subresources.layerCount &&
+                           subresources.baseLayer < other.baseLayer + other.layerCount;
+                });
+            }
+
+            BufferHandle declareBuffer(
+                const BufferHandle handle,
+                const uint64_t offset,
+                const uint64_t size,
+                const bool writes
+            ) {
+                validateType(handle, ResourceType::Buffer);
+
+                const auto& node = resources[handle.id.index];
+                const auto bufferSize = std::get<BufferFormat>(node.description).getSize();
+
+                if (size == 0 || offset >= bufferSize || size > bufferSize - offset)
+                    throw std::out_of_range{
+                        "Range of frame graph buffer '" + std::string{node.name} + "' exceeds its size"
+                    };
+
+                return declarePart(handle, writes, [offset, size](const ResourceUsage& usage) {
+                    const auto& other = std::get<BufferResourceUsage>(usage);
+
+                    return other.offset < offset + size && offset < other.offset + other.size;
+                });
             }
 
         public:
-            Builder(std::vector<ResourceNode>& resources, std::string name, const RenderPassType type)
-                : resources(resources),
-                  name(std::move(name)),
-                  type(type) {}
+            /**
+             * The name, usages and attachments of the pass are allocated from the memory resource of the resources.
+             * The declarations must already be in a scope unique to this pass.
+             */
+            Builder(
+                std::pmr::vector<ResourceNode>& resources,
+                PassDeclarations& declarations,
+                const FrameGraphName name,
+                const RenderPassType type
+            ) : resources(resources),
+                declarations(declarations),
+                name(name.getName(), resources.get_allocator()),
+                nameHash(name.getHash()),
+                type(type),
+                resourceUsages(resources.get_allocator()),
+                colorAttachments(resources.get_allocator()) {}
 
             Builder(const Builder& other) = delete;
 
@@ -176,16 +415,25 @@ namespace Vixen {
                 const ImageUsageBits usage,
                 const PipelineStageFlags stages
             ) {
-                validateCurrent(handle, ResourceType::Image);
-                validateUnused(handle.id);
+                return read(handle, usage, stages, getFullSubresourceRange(handle));
+            }
+
+            ImageHandle read(
+                const ImageHandle handle,
+                const ImageUsageBits usage,
+                const PipelineStageFlags stages,
+                const ImageSubresourceRange& subresources
+            ) {
+                const auto input = declareImage(handle, subresources, false);
 
                 resourceUsages.emplace_back(
                     ImageResourceUsage{
-                        .input = handle,
+                        .input = input,
                         .output = {},
                         .access = ResourceAccess::Read,
                         .usage = usage,
-                        .stages = stages
+                        .stages = stages,
+                        .subresources = subresources
                     }
                 );
 
@@ -197,7 +445,22 @@ namespace Vixen {
                 const ImageUsageBits usage,
                 const PipelineStageFlags stages
             ) {
-                const auto output = advance(handle, ResourceType::Image);
+                return write(handle, usage, stages, getFullSubresourceRange(handle));
+            }
+
+            ImageHandle write(
+                const ImageHandle handle,
+                const ImageUsageBits usage,
+                const PipelineStageFlags stages,
+                const ImageSubresourceRange& subresources
+            ) {
+                const auto input = declareImage(handle, subresources, true);
+                const ImageHandle output{
+                    .id = {
+                        .index = input.id.index,
+                        .version = resources[input.id.index].latestVersion
+                    }
+                };
 
                 resourceUsages.emplace_back(
                     ImageResourceUsage{
@@ -205,7 +468,8 @@ namespace Vixen {
                         .output = output,
                         .access = ResourceAccess::Write,
                         .usage = usage,
-                        .stages = stages
+                        .stages = stages,
+                        .subresources = subresources
                     }
                 );
 
@@ -217,15 +481,31 @@ namespace Vixen {
                 const ImageUsageBits usage,
                 const PipelineStageFlags stages
             ) {
-                const auto output = advance(handle, ResourceType::Image);
+                return readWrite(handle, usage, stages, getFullSubresourceRange(handle));
+            }
+
+            ImageHandle readWrite(
+                const ImageHandle handle,
+                const ImageUsageBits usage,
+                const PipelineStageFlags stages,
+                const ImageSubresourceRange& subresources
+            ) {
+                const auto input = declareImage(handle, subresources, true);
+                const ImageHandle output{
+                    .id = {
+                        .index = input.id.index,
+                        .version = resources[input.id.index].latestVersion
+                    }
+                };
 
                 resourceUsages.emplace_back(
                     ImageResourceUsage{
-                        .input = handle,
+                        .input = input,
                         .output = output,
                         .access = ResourceAccess::ReadWrite,
                         .usage = usage,
-                        .stages = stages
+                        .stages = stages,
+                        .subresources = subresources
                     }
                 );
 
@@ -237,16 +517,27 @@ namespace Vixen {
                 const BufferUsageBits usage,
                 const PipelineStageFlags stages
             ) {
-                validateCurrent(handle, ResourceType::Buffer);
-                validateUnused(handle.id);
+                return read(handle, usage, stages, 0, getWholeSize(handle));
+            }
+
+            BufferHandle read(
+                const BufferHandle handle,
+                const BufferUsageBits usage,
+                const PipelineStageFlags stages,
+                const uint64_t offset,
+                const uint64_t size
+            ) {
+                const auto input = declareBuffer(handle, offset, size, false);
 
                 resourceUsages.emplace_back(
                     BufferResourceUsage{
-                        .input = handle,
+                        .input = input,
                         .output = {},
                         .access = ResourceAccess::Read,
                         .usage = usage,
-                        .stages = stages
+                        .stages = stages,
+                        .offset = offset,
+                        .size = size
                     }
                 );
 
@@ -258,7 +549,23 @@ namespace Vixen {
                 const BufferUsageBits usage,
                 const PipelineStageFlags stages
             ) {
-                const auto output = advance(handle, ResourceType::Buffer);
+                return write(handle, usage, stages, 0, getWholeSize(handle));
+            }
+
+            BufferHandle write(
+                const BufferHandle handle,
+                const BufferUsageBits usage,
+                const PipelineStageFlags stages,
+                const uint64_t offset,
+                const uint64_t size
+            ) {
+                const auto input = declareBuffer(handle, offset, size, true);
+                const BufferHandle output{
+                    .id = {
+                        .index = input.id.index,
+                        .version = resources[input.id.index].latestVersion
+                    }
+                };
 
                 resourceUsages.emplace_back(
                     BufferResourceUsage{
@@ -266,7 +573,9 @@ namespace Vixen {
                         .output = output,
                         .access = ResourceAccess::Write,
                         .usage = usage,
-                        .stages = stages
+                        .stages = stages,
+                        .offset = offset,
+                        .size = size
                     }
                 );
 
@@ -278,15 +587,33 @@ namespace Vixen {
                 const BufferUsageBits usage,
                 const PipelineStageFlags stages
             ) {
-                const auto output = advance(handle, ResourceType::Buffer);
+                return readWrite(handle, usage, stages, 0, getWholeSize(handle));
+            }
+
+            BufferHandle readWrite(
+                const BufferHandle handle,
+                const BufferUsageBits usage,
+                const PipelineStageFlags stages,
+                const uint64_t offset,
+                const uint64_t size
+            ) {
+                const auto input = declareBuffer(handle, offset, size, true);
+                const BufferHandle output{
+                    .id = {
+                        .index = input.id.index,
+                        .version = resources[input.id.index].latestVersion
+                    }
+                };
 
                 resourceUsages.emplace_back(
                     BufferResourceUsage{
-                        .input = handle,
+                        .input = input,
                         .output = output,
                         .access = ResourceAccess::ReadWrite,
                         .usage = usage,
-                        .stages = stages
+                        .stages = stages,
+                        .offset = offset,
+                        .size = size
                     }
                 );
 
@@ -360,6 +687,14 @@ namespace Vixen {
                 return output;
             }
 
+            /**
+             * Marks the pass as having effects outside the frame graph, such as host readbacks or queries. Passes
+             * with side effects are never culled, even when none of their outputs are consumed.
+             */
+            void setSideEffects(const bool hasSideEffects = true) noexcept {
+                sideEffects = hasSideEffects;
+            }
+
             template <typename Data, typename Execute>
             [[nodiscard]]
             RenderPass build(
@@ -391,11 +726,13 @@ namespace Vixen {
 
                 return RenderPass(
                     std::move(name),
+                    nameHash,
                     type,
                     std::move(resourceUsages),
                     std::move(colorAttachments),
                     std::move(depthStencilAttachment),
-                    ExecuteCallback(std::move(callback))
+                    sideEffects,
+                    ExecuteCallback(std::move(callback), resources.get_allocator().resource())
                 );
             }
         };
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
+
 namespace Vixen {
     class FrameGraphResources;
     struct CommandBuffer;
@@ -11,5 +14,10 @@ namespace Vixen {
         CommandBuffer* commandBuffer;
 
         const FrameGraphResources& resources;
+
+        /**
+         * The average time the pass took on the GPU in the frames it was measured in, when the graph is profiled.
+         */
+        std::optional<std::chrono::nanoseconds> gpuTime;
     };
 }
@@ -9,6 +9,7 @@
 #include "../PipelineStageFlags.h"
 #include "../buffer/BufferUsage.h"
 #include "../image/ImageLayout.h"
+#include "../image/ImageSubresourceRange.h"
 #include "../image/ImageUsage.h"
 
 namespace Vixen {
@@ -69,6 +70,21 @@ namespace Vixen {
     using ImageHandle = ResourceHandle<ImageTag>;
     using BufferHandle = ResourceHandle<BufferTag>;
 
+    /**
+     * An image kept across frames, through which passes read what the last frame wrote to it while writing this
+     * frame's contents.
+     */
+    struct HistoryImage {
+        ImageHandle current;
+
+        ImageHandle previous;
+
+        /**
+         * False on the first frame of the history, when the previous image holds nothing yet.
+         */
+        bool valid;
+    };
+
     struct ImageResourceUsage {
         ImageHandle input;
         ImageHandle output;
@@ -78,6 +94,12 @@ namespace Vixen {
         ImageUsageBits usage;
 
         PipelineStageFlags stages;
+
+        /**
+         * The mipmaps and layers the pass uses. Their states are tracked apart from the rest of the image, but always
+         * across every aspect of its format.
+         */
+        ImageSubresourceRange subresources;
     };
 
     struct BufferResourceUsage {
@@ -89,6 +111,13 @@ namespace Vixen {
         BufferUsageBits usage;
 
         PipelineStageFlags stages;
+
+        /**
+         * The range of bytes the pass uses, whose state is tracked apart from the rest of the buffer.
+         */
+        uint64_t offset;
+
+        uint64_t size;
     };
 
     using ResourceUsage = std::variant<ImageResourceUsage, BufferResourceUsage>;
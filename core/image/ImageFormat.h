@@ -18,5 +18,7 @@ namespace Vixen {
         ImageType type;
         ImageSamples samples;
         ImageUsageFlags usage;
+
+        bool operator==(const ImageFormat& other) const = default;
     };
 }
@@ -10,5 +10,7 @@ namespace Vixen {
         ImageSwizzle swizzleGreen;
         ImageSwizzle swizzleBlue;
         ImageSwizzle swizzleAlpha;
+
+        bool operator==(const ImageView& other) const = default;
     };
 }
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/buffer/Buffer.h"
+
+namespace Vixen {
+    struct NullBuffer final : Buffer {
+        using Buffer::Buffer;
+
+        /**
+         * Host memory handed out when the buffer is mapped, allocated on first use.
+         */
+        std::vector<std::byte> memory;
+    };
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "core/ImageBarrier.h"
+#include "core/command/CommandBuffer.h"
+
+namespace Vixen {
+    struct Event;
+
+    /**
+     * The number of commands of each kind recorded into command buffers.
+     */
+    struct NullCommandCounts {
+        uint64_t commands = 0;
+        uint64_t renderPasses = 0;
+        uint64_t pipelineBarriers = 0;
+        uint64_t memoryBarriers = 0;
+        uint64_t bufferBarriers = 0;
+        uint64_t imageBarriers = 0;
+        uint64_t eventCommands = 0;
+        uint64_t transfers = 0;
+        uint64_t labels = 0;
+
+        NullCommandCounts& operator+=(const NullCommandCounts& other) {
+            commands += other.commands;
+            renderPasses += other.renderPasses;
+            pipelineBarriers += other.pipelineBarriers;
+            memoryBarriers += other.memoryBarriers;
+            bufferBarriers += other.bufferBarriers;
+            imageBarriers += other.imageBarriers;
+            eventCommands += other.eventCommands;
+            transfers += other.transfers;
+            labels += other.labels;
+
+            return *this;
+        }
+    };
+
+    enum class NullEventOperation {
+        Set,
+        Wait,
+        Reset
+    };
+
+    /**
+     * An event command, replayed on submission to check that events are only waited on once they have been set. The
+     * image barriers of a wait are applied when it is replayed.
+     */
+    struct NullEventCommand {
+        Event* event;
+        NullEventOperation operation;
+    };
+
+    struct NullCommandBuffer;
+
+    /**
+     * A command that changes state visible to other command buffers, which is replayed when the command buffer it was
+     * recorded into is submitted.
+     */
+    using NullCommand = std::variant<ImageBarrier, NullEventCommand, NullCommandBuffer*>;
+
+    struct NullCommandBuffer final : CommandBuffer {
+        uint32_t queueFamily = 0;
+
+        bool recording = false;
+
+        bool rendering = false;
+
+        uint32_t openLabels = 0;
+
+        NullCommandCounts counts{};
+
+        std::vector<NullCommand> commands;
+
+        /**
+         * The misuse found while recording, reported once the command buffer is submitted, so recording on several
+         * threads at once never contends on the driver.
+         */
+        std::vector<std::string> errors;
+    };
+}
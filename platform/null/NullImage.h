@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/image/Image.h"
+#include "core/image/ImageLayout.h"
+
+namespace Vixen {
+    struct NullImage final : Image {
+        /**
+         * Host memory handed out when the image is mapped, allocated on first use.
+         */
+        std::vector<std::byte> memory;
+
+        /**
+         * The layout of every subresource as of the last submitted barrier, indexed by layer and then mipmap.
+         */
+        std::vector<ImageLayout> layouts;
+    };
+}
@@ -0,0 +1,70 @@
+#include "NullRenderingContextDriver.h"
+
+#include "NullRenderingDeviceDriver.h"
+#include "core/Surface.h"
+
+namespace Vixen {
+    std::vector<DriverDevice> NullRenderingContextDriver::getDevices() {
+        return {
+            {
+                .name = "Null Device",
+                .type = DriverDeviceType::Cpu
+            }
+        };
+    }
+
+    bool NullRenderingContextDriver::deviceSupportsPresent(
+        uint32_t,
+        Surface*
+    ) {
+        return true;
+    }
+
+    RenderingDeviceDriver* NullRenderingContextDriver::createRenderingDeviceDriver(
+        uint32_t,
+        uint32_t
+    ) {
+        return new NullRenderingDeviceDriver();
+    }
+
+    void NullRenderingContextDriver::destroyRenderingDeviceDriver(RenderingDeviceDriver* renderingDeviceDriver) {
+        delete dynamic_cast<NullRenderingDeviceDriver*>(renderingDeviceDriver);
+    }
+
+    auto NullRenderingContextDriver::createSurface(
+        Window*
+    ) -> std::expected<Surface*, Error> {
+        return new Surface();
+    }
+
+    bool NullRenderingContextDriver::getSurfaceNeedsResize(Surface* surface) {
+        return surface->isResizeRequired;
+    }
+
+    void NullRenderingContextDriver::setSurfaceNeedsResize(Surface* surface, const bool needsResize) {
+        surface->isResizeRequired = needsResize;
+    }
+
+    void NullRenderingContextDriver::setSurfaceSize(Surface* surface, const uint32_t width, const uint32_t height) {
+        surface->resolution = {
+            width,
+            height
+        };
+        surface->isResizeRequired = true;
+    }
+
+    void NullRenderingContextDriver::setSurfaceVSyncMode(Surface* surface, const VSyncMode vsyncMode) {
+        surface->vsyncMode = vsyncMode;
+        surface->isResizeRequired = true;
+    }
+
+    void NullRenderingContextDriver::setSurfaceWindowMode(Surface* surface, const WindowMode mode) {
+        surface->windowMode = mode;
+    }
+
+    void NullRenderingContextDriver::destroySurface(
+        Surface* surface
+    ) {
+        delete surface;
+    }
+}
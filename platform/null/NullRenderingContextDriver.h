@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/RenderingContextDriver.h"
+
+namespace Vixen {
+    /**
+     * A rendering context with a single null device, which runs entirely on the CPU. Its surfaces only keep the size
+     * and modes of their windows, so a rendering device can be created with or without a window on machines without a
+     * GPU.
+     */
+    class NullRenderingContextDriver final : public RenderingContextDriver {
+    public:
+        std::vector<DriverDevice> getDevices() override;
+
+        bool deviceSupportsPresent(
+            uint32_t deviceIndex,
+            Surface* surface
+        ) override;
+
+        RenderingDeviceDriver* createRenderingDeviceDriver(
+            uint32_t deviceIndex,
+            uint32_t frameCount
+        ) override;
+
+        void destroyRenderingDeviceDriver(RenderingDeviceDriver* renderingDeviceDriver) override;
+
+        auto createSurface(Window* window) -> std::expected<Surface*, Error> override;
+
+        bool getSurfaceNeedsResize(Surface* surface) override;
+
+        void setSurfaceNeedsResize(Surface* surface, bool needsResize) override;
+
+        void setSurfaceSize(Surface* surface, uint32_t width, uint32_t height) override;
+
+        void setSurfaceVSyncMode(Surface* surface, VSyncMode vsyncMode) override;
+
+        void setSurfaceWindowMode(Surface* surface, WindowMode mode) override;
+
+        void destroySurface(
+            Surface* surface
+        ) override;
+    };
+}
@@ -0,0 +1,1020 @@
+#include "NullRenderingDeviceDriver.h"
+
+#include <algorithm>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+#include "NullBuffer.h"
+#include "NullImage.h"
+#include "NullSemaphore.h"
+#include "NullSwapchain.h"
+#include "core/AttachmentInfo.h"
+#include "core/Framebuffer.h"
+#include "core/MemoryAlignment.h"
+#include "core/MemoryAllocation.h"
+#include "core/QueueFamilyFlags.h"
+#include "core/buffer/Buffer.h"
+#include "core/command/CommandPool.h"
+#include "core/command/CommandQueue.h"
+#include "core/command/Event.h"
+#include "core/command/Fence.h"
+#include "core/command/QueryPool.h"
+#include "core/command/Semaphore.h"
+#include "core/error/CantCreateError.h"
+#include "core/error/Error.h"
+#include "core/error/Macros.h"
+#include "core/error/Shader.h"
+#include "core/error/SwapchainError.h"
+#include "core/image/Sampler.h"
+#include "core/shader/Shader.h"
+
+namespace Vixen {
+    namespace {
+        /**
+         * The size of the largest texel of any image format, four 32-bit channels.
+         */
+        constexpr uint64_t MaxTexelSize = 16;
+
+        std::string getLayoutName(const ImageLayout layout) {
+            switch (layout) {
+                    using enum ImageLayout;
+
+                case Undefined:
+                    return "Undefined";
+                case General:
+                    return "General";
+                case StorageOptimal:
+                    return "StorageOptimal";
+                case ColorAttachmentOptimal:
+                    return "ColorAttachmentOptimal";
+                case DepthStencilAttachmentOptimal:
+                    return "DepthStencilAttachmentOptimal";
+                case DepthStencilReadOnlyOptimal:
+                    return "DepthStencilReadOnlyOptimal";
+                case ShaderReadOnlyOptimal:
+                    return "ShaderReadOnlyOptimal";
+                case CopySourceOptimal:
+                    return "CopySourceOptimal";
+                case CopyDestinationOptimal:
+                    return "CopyDestinationOptimal";
+                case ResolveSourceOptimal:
+                    return "ResolveSourceOptimal";
+                case ResolveDestinationOptimal:
+                    return "ResolveDestinationOptimal";
+            }
+
+            return "Unknown";
+        }
+
+        /**
+         * Counts a command recorded into the command buffer, noting an error if the command buffer is not recording.
+         */
+        NullCommandBuffer* recordCommand(
+            CommandBuffer* commandBuffer,
+            const std::string_view command
+        ) {
+            const auto nullCommandBuffer = static_cast<NullCommandBuffer*>(commandBuffer);
+            if (!nullCommandBuffer->recording)
+                nullCommandBuffer->errors.push_back(
+                    std::string(command) + " was recorded into a command buffer that is not recording."
+                );
+
+            nullCommandBuffer->counts.commands++;
+
+            return nullCommandBuffer;
+        }
+
+        /**
+         * Counts a command that may not be recorded inside a render pass.
+         */
+        NullCommandBuffer* recordCommandOutsideRenderPass(
+            CommandBuffer* commandBuffer,
+            const std::string_view command
+        ) {
+            const auto nullCommandBuffer = recordCommand(commandBuffer, command);
+            if (nullCommandBuffer->rendering)
+                nullCommandBuffer->errors.push_back(std::string(command) + " was recorded inside a render pass.");
+
+            return nullCommandBuffer;
+        }
+
+        NullCommandBuffer* recordTransfer(
+            CommandBuffer* commandBuffer,
+            const std::string_view command
+        ) {
+            const auto nullCommandBuffer = recordCommandOutsideRenderPass(commandBuffer, command);
+            nullCommandBuffer->counts.transfers++;
+
+            return nullCommandBuffer;
+        }
+
+        void countBarriers(
+            NullCommandBuffer* commandBuffer,
+            const std::span<const MemoryBarrier> memoryBarriers,
+            const std::span<const BufferBarrier> bufferBarriers,
+            const std::span<const ImageBarrier> imageBarriers
+        ) {
+            commandBuffer->counts.memoryBarriers += memoryBarriers.size();
+            commandBuffer->counts.bufferBarriers += bufferBarriers.size();
+            commandBuffer->counts.imageBarriers += imageBarriers.size();
+        }
+    }
+
+    uint64_t NullRenderingDeviceDriver::getImageSize(
+        const ImageFormat& format
+    ) {
+        return static_cast<uint64_t>(format.width) * format.height * format.depth * format.layerCount * MaxTexelSize;
+    }
+
+    void NullRenderingDeviceDriver::countObject(
+        uint64_t Statistics::* objects,
+        const bool created
+    ) {
+        std::scoped_lock lock(mutex);
+        if (created)
+            statistics.*objects += 1;
+        else
+            statistics.*objects -= 1;
+    }
+
+    void NullRenderingDeviceDriver::destroySwapchainFramebuffers(
+        Swapchain* swapchain
+    ) {
+        auto& framebuffers = static_cast<NullSwapchain*>(swapchain)->framebuffers;
+        for (const auto framebuffer : framebuffers) {
+            destroyImage(framebuffer->colorTarget);
+            destroyImage(framebuffer->depthTarget);
+            delete framebuffer;
+        }
+        framebuffers.clear();
+    }
+
+    void NullRenderingDeviceDriver::addValidationError(
+        std::string message
+    ) {
+        spdlog::error("[Null] {}", message);
+
+        statistics.validationErrors++;
+        if (validationErrors.size() < MaxValidationErrors)
+            validationErrors.push_back(std::move(message));
+    }
+
+    void NullRenderingDeviceDriver::replayImageBarrier(
+        const NullCommandBuffer& commandBuffer,
+        const ImageBarrier& barrier
+    ) {
+        if (barrier.image == nullptr) {
+            addValidationError("An image barrier was recorded without an image.");
+            return;
+        }
+
+        const auto image = static_cast<NullImage*>(barrier.image);
+        const auto& range = barrier.subresources;
+        const auto& format = image->format;
+        if (range.mipmapCount == 0 || range.layerCount == 0 ||
+            range.baseMipmap + range.mipmapCount > format.mipmapCount ||
+            range.baseLayer + range.layerCount > format.layerCount) {
+            addValidationError(
+                "An image barrier covers mipmaps " + std::to_string(range.baseMipmap) + "+" +
+                std::to_string(range.mipmapCount) + " and layers " + std::to_string(range.baseLayer) + "+" +
+                std::to_string(range.layerCount) + " of an image with " + std::to_string(format.mipmapCount) +
+                " mipmaps and " + std::to_string(format.layerCount) + " layers."
+            );
+            return;
+        }
+
+        const bool transfersOwnership = barrier.sourceQueueFamily != barrier.destinationQueueFamily &&
+            barrier.sourceQueueFamily != QueueFamilyIgnored && barrier.destinationQueueFamily != QueueFamilyIgnored;
+        if (transfersOwnership && commandBuffer.queueFamily != barrier.sourceQueueFamily &&
+            commandBuffer.queueFamily != barrier.destinationQueueFamily)
+            addValidationError(
+                "An image barrier transferring ownership from queue family " +
+                std::to_string(barrier.sourceQueueFamily) + " to " + std::to_string(barrier.destinationQueueFamily) +
+                " was recorded into a command buffer of queue family " + std::to_string(commandBuffer.queueFamily) +
+                "."
+            );
+
+        bool mismatched = false;
+        for (uint32_t layer = range.baseLayer; layer < range.baseLayer + range.layerCount; ++layer) {
+            for (uint32_t mipmap = range.baseMipmap; mipmap < range.baseMipmap + range.mipmapCount; ++mipmap) {
+                auto& layout = image->layouts[layer * format.mipmapCount + mipmap];
+
+                // Both halves of an ownership transfer carry the same transition, which only happens once
+                const bool transitioned = transfersOwnership && layout == barrier.newLayout;
+                if (barrier.oldLayout != ImageLayout::Undefined && layout != barrier.oldLayout && !transitioned &&
+                    !mismatched) {
+                    addValidationError(
+                        "An image barrier expects mipmap " + std::to_string(mipmap) + " of layer " +
+                        std::to_string(layer) + " to be in " + getLayoutName(barrier.oldLayout) +
+                        ", but it is in " + getLayoutName(layout) + "."
+                    );
+                    mismatched = true;
+                }
+
+                layout = barrier.newLayout;
+            }
+        }
+    }
+
+    void NullRenderingDeviceDriver::replay(
+        const NullCommandBuffer& commandBuffer
+    ) {
+        for (const auto& error : commandBuffer.errors)
+            addValidationError(error);
+        statistics.commands += commandBuffer.counts;
+
+        for (const auto& command : commandBuffer.commands) {
+            if (const auto barrier = std::get_if<ImageBarrier>(&command)) {
+                replayImageBarrier(commandBuffer, *barrier);
+            } else if (const auto eventCommand = std::get_if<NullEventCommand>(&command)) {
+                switch (eventCommand->operation) {
+                    case NullEventOperation::Set:
+                        events[eventCommand->event] = true;
+                        break;
+
+                    case NullEventOperation::Wait:
+                        if (!events[eventCommand->event])
+                            addValidationError("An event was waited on before it was set.");
+                        break;
+
+                    case NullEventOperation::Reset:
+                        events[eventCommand->event] = false;
+                        break;
+                }
+            } else {
+                replay(*std::get<NullCommandBuffer*>(command));
+            }
+        }
+    }
+
+    NullRenderingDeviceDriver::~NullRenderingDeviceDriver() {
+        const std::pair<const char*, uint64_t> objects[] = {
+            {"images", statistics.images},
+            {"buffers", statistics.buffers},
+            {"memory allocations", statistics.memoryAllocations},
+            {"samplers", statistics.samplers},
+            {"shaders", statistics.shaders},
+            {"swapchains", statistics.swapchains},
+            {"command queues", statistics.commandQueues},
+            {"command pools", statistics.commandPools},
+            {"fences", statistics.fences},
+            {"semaphores", statistics.semaphores},
+            {"events", statistics.events},
+            {"query pools", statistics.queryPools}
+        };
+
+        for (const auto& [name, count] : objects)
+            if (count != 0)
+                spdlog::warn("[Null] The device was destroyed with {} {} still alive.", count, name);
+    }
+
+    auto NullRenderingDeviceDriver::getStatistics() const -> Statistics {
+        std::scoped_lock lock(mutex);
+
+        return statistics;
+    }
+
+    std::vector<std::string> NullRenderingDeviceDriver::getValidationErrors() const {
+        std::scoped_lock lock(mutex);
+
+        return validationErrors;
+    }
+
+    void NullRenderingDeviceDriver::clearValidationErrors() {
+        std::scoped_lock lock(mutex);
+
+        validationErrors.clear();
+        statistics.validationErrors = 0;
+    }
+
+    auto NullRenderingDeviceDriver::createSwapchain(
+        Surface* surface
+    ) -> std::expected<Swapchain*, Error> {
+        const auto swapchain = new NullSwapchain();
+        swapchain->surface = surface;
+        countObject(&Statistics::swapchains, true);
+
+        return swapchain;
+    }
+
+    auto NullRenderingDeviceDriver::resizeSwapchain(
+        CommandQueue*,
+        Swapchain* swapchain,
+        const uint32_t imageCount
+    ) -> std::expected<void, Error> {
+        const auto nullSwapchain = static_cast<NullSwapchain*>(swapchain);
+        destroySwapchainFramebuffers(swapchain);
+
+        // A minimized window has no area, but its images still need one
+        const auto width = std::max(nullSwapchain->surface->resolution.x, 1u);
+        const auto height = std::max(nullSwapchain->surface->resolution.y, 1u);
+        for (uint32_t i = 0; i < imageCount; ++i) {
+            const auto framebuffer = new Framebuffer();
+            framebuffer->colorTarget = createImage(
+                {
+                    .format = B8G8R8A8_UNORM,
+                    .width = width,
+                    .height = height,
+                    .depth = 1,
+                    .layerCount = 1,
+                    .mipmapCount = 1,
+                    .type = ImageType::TwoD,
+                    .samples = ImageSamples::One,
+                    .usage = ImageUsageBits::ColorAttachment | ImageUsageBits::CopySource
+                },
+                {
+                    .format = B8G8R8A8_UNORM,
+                    .swizzleRed = ImageSwizzle::Red,
+                    .swizzleGreen = ImageSwizzle::Green,
+                    .swizzleBlue = ImageSwizzle::Blue,
+                    .swizzleAlpha = ImageSwizzle::Alpha
+                }
+            ).value();
+            framebuffer->depthTarget = createImage(
+                {
+                    .format = D32_SFLOAT_S8_UINT,
+                    .width = width,
+                    .height = height,
+                    .depth = 1,
+                    .layerCount = 1,
+                    .mipmapCount = 1,
+                    .type = ImageType::TwoD,
+                    .samples = ImageSamples::One,
+                    .usage = ImageUsageBits::DepthStencilAttachment
+                },
+                {
+                    .format = D32_SFLOAT_S8_UINT,
+                    .swizzleRed = ImageSwizzle::Red,
+                    .swizzleGreen = ImageSwizzle::Green,
+                    .swizzleBlue = ImageSwizzle::Blue,
+                    .swizzleAlpha = ImageSwizzle::Alpha
+                }
+            ).value();
+
+            nullSwapchain->framebuffers.push_back(framebuffer);
+        }
+
+        nullSwapchain->imageIndex = 0;
+        nullSwapchain->surface->isResizeRequired = false;
+
+        return {};
+    }
+
+    auto NullRenderingDeviceDriver::acquireSwapchainFramebuffer(
+        CommandQueue*,
+        Swapchain* swapchain
+    ) -> std::expected<Framebuffer*, SwapchainError> {
+        const auto nullSwapchain = static_cast<NullSwapchain*>(swapchain);
+        if (nullSwapchain->framebuffers.empty() || nullSwapchain->surface->isResizeRequired)
+            return std::unexpected(SwapchainError::ResizeRequired);
+
+        const auto framebuffer = nullSwapchain->framebuffers[nullSwapchain->imageIndex];
+        nullSwapchain->imageIndex = (nullSwapchain->imageIndex + 1) % nullSwapchain->framebuffers.size();
+
+        // The contents of an acquired image are whatever presentation left behind
+        std::ranges::fill(static_cast<NullImage*>(framebuffer->colorTarget)->layouts, ImageLayout::Undefined);
+
+        return framebuffer;
+    }
+
+    void NullRenderingDeviceDriver::destroySwapchain(
+        Swapchain* swapchain
+    ) {
+        destroySwapchainFramebuffers(swapchain);
+        delete swapchain;
+        countObject(&Statistics::swapchains, false);
+    }
+
+    auto NullRenderingDeviceDriver::createFence() -> std::expected<Fence*, Error> {
+        countObject(&Statistics::fences, true);
+
+        return new Fence();
+    }
+
+    auto NullRenderingDeviceDriver::waitOnFence(
+        Fence*
+    ) -> std::expected<void, Error> {
+        return {};
+    }
+
+    void NullRenderingDeviceDriver::destroyFence(
+        Fence* fence
+    ) {
+        delete fence;
+        countObject(&Statistics::fences, false);
+    }
+
+    auto NullRenderingDeviceDriver::createSemaphore() -> std::expected<Semaphore*, Error> {
+        countObject(&Statistics::semaphores, true);
+
+        return new NullSemaphore();
+    }
+
+    auto NullRenderingDeviceDriver::waitOnSemaphore(
+        Semaphore* semaphore,
+        const uint64_t value
+    ) -> std::expected<void, Error> {
+        std::scoped_lock lock(mutex);
+
+        if (value > static_cast<NullSemaphore*>(semaphore)->value)
+            addValidationError("A semaphore was waited on for a value it will never be signalled with.");
+
+        return {};
+    }
+
+    auto NullRenderingDeviceDriver::getSemaphoreValue(
+        Semaphore* semaphore
+    ) -> std::expected<uint64_t, Error> {
+        std::scoped_lock lock(mutex);
+
+        return static_cast<NullSemaphore*>(semaphore)->value;
+    }
+
+    void NullRenderingDeviceDriver::destroySemaphore(
+        Semaphore* semaphore
+    ) {
+        delete semaphore;
+        countObject(&Statistics::semaphores, false);
+    }
+
+    auto NullRenderingDeviceDriver::createEvent() -> std::expected<Event*, Error> {
+        countObject(&Statistics::events, true);
+
+        return new Event();
+    }
+
+    void NullRenderingDeviceDriver::destroyEvent(
+        Event* event
+    ) {
+        {
+            std::scoped_lock lock(mutex);
+            events.erase(event);
+        }
+
+        delete event;
+        countObject(&Statistics::events, false);
+    }
+
+    auto NullRenderingDeviceDriver::createQueryPool(
+        uint32_t
+    ) -> std::expected<QueryPool*, Error> {
+        countObject(&Statistics::queryPools, true);
+
+        return new QueryPool();
+    }
+
+    auto NullRenderingDeviceDriver::getQueryPoolResults(
+        QueryPool*,
+        uint32_t,
+        const uint32_t count
+    ) -> std::expected<std::vector<std::optional<uint64_t>>, Error> {
+        // Nothing runs on this device, so all of its work completes at once.
+        return std::vector<std::optional<uint64_t>>(count, 0);
+    }
+
+    void NullRenderingDeviceDriver::destroyQueryPool(
+        QueryPool* pool
+    ) {
+        delete pool;
+        countObject(&Statistics::queryPools, false);
+    }
+
+    auto NullRenderingDeviceDriver::createCommandPool(
+        const uint32_t queueFamily,
+        const CommandBufferType type
+    ) -> std::expected<CommandPool*, Error> {
+        const auto pool = new CommandPool();
+        pool->queueFamily = queueFamily;
+        pool->type = type;
+        countObject(&Statistics::commandPools, true);
+
+        return pool;
+    }
+
+    auto NullRenderingDeviceDriver::resetCommandPool(
+        CommandPool*
+    ) -> std::expected<void, Error> {
+        return {};
+    }
+
+    void NullRenderingDeviceDriver::destroyCommandPool(
+        CommandPool* pool
+    ) {
+        delete pool;
+        countObject(&Statistics::commandPools, false);
+    }
+
+    auto NullRenderingDeviceDriver::createCommandBuffer(
+        CommandPool* pool
+    ) -> std::expected<CommandBuffer*, Error> {
+        const auto commandBuffer = new NullCommandBuffer();
+        commandBuffer->queueFamily = pool->queueFamily;
+
+        return commandBuffer;
+    }
+
+    auto NullRenderingDeviceDriver::beginCommandBuffer(
+        CommandBuffer* commandBuffer
+    ) -> std::expected<void, Error> {
+        const auto nullCommandBuffer = static_cast<NullCommandBuffer*>(commandBuffer);
+        nullCommandBuffer->recording = true;
+        nullCommandBuffer->rendering = false;
+        nullCommandBuffer->openLabels = 0;
+        nullCommandBuffer->counts = {};
+        nullCommandBuffer->commands.clear();
+        nullCommandBuffer->errors.clear();
+
+        return {};
+    }
+
+    void NullRenderingDeviceDriver::endCommandBuffer(
+        CommandBuffer* commandBuffer
+    ) {
+        const auto nullCommandBuffer = static_cast<NullCommandBuffer*>(commandBuffer);
+        if (!nullCommandBuffer->recording)
+            nullCommandBuffer->errors.push_back("A command buffer that is not recording was ended.");
+        if (nullCommandBuffer->rendering)
+            nullCommandBuffer->errors.push_back("A command buffer was ended inside a render pass.");
+        if (nullCommandBuffer->openLabels != 0)
+            nullCommandBuffer->errors.push_back(
+                "A command buffer was ended with " + std::to_string(nullCommandBuffer->openLabels) +
+                " labels still open."
+            );
+
+        nullCommandBuffer->recording = false;
+    }
+
+    auto NullRenderingDeviceDriver::createBuffer(
+        const BufferUsageFlags usage,
+        const uint32_t count,
+        const uint32_t stride
+    ) -> std::expected<Buffer*, Error> {
+        countObject(&Statistics::buffers, true);
+
+        return new NullBuffer(usage, count, stride);
+    }
+
+    void NullRenderingDeviceDriver::destroyBuffer(
+        Buffer* buffer
+    ) {
+        delete buffer;
+        countObject(&Statistics::buffers, false);
+    }
+
+    std::byte* NullRenderingDeviceDriver::mapBuffer(
+        Buffer* buffer
+    ) {
+        auto& memory = static_cast<NullBuffer*>(buffer)->memory;
+        if (memory.empty())
+            memory.resize(buffer->getSize());
+
+        return memory.data();
+    }
+
+    void NullRenderingDeviceDriver::unmapBuffer(
+        Buffer*
+    ) {}
+
+    auto NullRenderingDeviceDriver::getQueueFamily(
+        QueueFamilyFlags,
+        Surface*
+    ) -> std::expected<uint32_t, Error> {
+        return 0;
+    }
+
+    auto NullRenderingDeviceDriver::createCommandQueue(
+        uint32_t
+    ) -> std::expected<CommandQueue*, Error> {
+        countObject(&Statistics::commandQueues, true);
+
+        return new CommandQueue();
+    }
+
+    auto NullRenderingDeviceDriver::executeCommandQueueAndPresent(
+        CommandQueue*,
+        const std::vector<Semaphore*>&,
+        const std::vector<CommandBuffer*>& commandBuffers,
+        const std::vector<Semaphore*>& signalSemaphores,
+        Fence*,
+        const std::vector<Swapchain*>& swapchains
+    ) -> std::expected<void, Error> {
+        std::scoped_lock lock(mutex);
+
+        for (const auto commandBuffer : commandBuffers) {
+            const auto nullCommandBuffer = static_cast<NullCommandBuffer*>(commandBuffer);
+            if (nullCommandBuffer->recording)
+                addValidationError("A command buffer was submitted before it was ended.");
+
+            replay(*nullCommandBuffer);
+        }
+
+        if (!commandBuffers.empty()) {
+            for (const auto semaphore : signalSemaphores)
+                static_cast<NullSemaphore*>(semaphore)->value++;
+
+            statistics.submissions++;
+        }
+        statistics.presentations += swapchains.size();
+
+        return {};
+    }
+
+    void NullRenderingDeviceDriver::destroyCommandQueue(
+        CommandQueue* commandQueue
+    ) {
+        delete commandQueue;
+        countObject(&Statistics::commandQueues, false);
+    }
+
+    auto NullRenderingDeviceDriver::createImage(
+        const ImageFormat& format,
+        const ImageView& view
+    ) -> std::expected<Image*, Error> {
+        const auto image = new NullImage();
+        image->format = format;
+        image->view = view;
+        image->layouts.assign(static_cast<std::size_t>(format.layerCount) * format.mipmapCount, ImageLayout::Undefined);
+        countObject(&Statistics::images, true);
+
+        return image;
+    }
+
+    auto NullRenderingDeviceDriver::getBufferMemoryRequirements(
+        BufferUsageFlags,
+        const uint32_t count,
+        const uint32_t stride
+    ) -> std::expected<MemoryRequirements, Error> {
+        return MemoryRequirements{
+            .size = alignUp(static_cast<uint64_t>(count) * stride, MemoryAlignment),
+            .alignment = MemoryAlignment,
+            .memoryTypeBits = 1
+        };
+    }
+
+    auto NullRenderingDeviceDriver::getImageMemoryRequirements(
+        const ImageFormat& format
+    ) -> std::expected<MemoryRequirements, Error> {
+        return MemoryRequirements{
+            .size = alignUp(getImageSize(format), MemoryAlignment),
+            .alignment = MemoryAlignment,
+            .memoryTypeBits = 1
+        };
+    }
+
+    auto NullRenderingDeviceDriver::allocateMemory(
+        const MemoryRequirements& requirements
+    ) -> std::expected<MemoryAllocation*, Error> {
+        const auto allocation = new MemoryAllocation();
+        allocation->size = requirements.size;
+        countObject(&Statistics::memoryAllocations, true);
+
+        return allocation;
+    }
+
+    void NullRenderingDeviceDriver::freeMemory(
+        MemoryAllocation* allocation
+    ) {
+        delete allocation;
+        countObject(&Statistics::memoryAllocations, false);
+    }
+
+    auto NullRenderingDeviceDriver::createAliasedBuffer(
+        const BufferUsageFlags usage,
+        const uint32_t count,
+        const uint32_t stride,
+        MemoryAllocation* allocation,
+        const uint64_t offset
+    ) -> std::expected<Buffer*, Error> {
+        if (offset + static_cast<uint64_t>(count) * stride > allocation->size)
+            return std::unexpected(Error::InitializationFailed);
+
+        return createBuffer(usage, count, stride);
+    }
+
+    auto NullRenderingDeviceDriver::createAliasedImage(
+        const ImageFormat& format,
+        const ImageView& view,
+        MemoryAllocation* allocation,
+        const uint64_t offset
+    ) -> std::expected<Image*, Error> {
+        if (offset + getImageSize(format) > allocation->size)
+            return std::unexpected(Error::InitializationFailed);
+
+        return createImage(format, view);
+    }
+
+    std::byte* NullRenderingDeviceDriver::mapImage(
+        Image* image
+    ) {
+        auto& memory = static_cast<NullImage*>(image)->memory;
+        if (memory.empty())
+            memory.resize(getImageSize(image->format));
+
+        return memory.data();
+    }
+
+    void NullRenderingDeviceDriver::unmapImage(
+        Image*
+    ) {}
+
+    void NullRenderingDeviceDriver::destroyImage(
+        Image* image
+    ) {
+        delete image;
+        countObject(&Statistics::images, false);
+    }
+
+    auto NullRenderingDeviceDriver::createSampler(
+        const SamplerState state
+    ) -> std::expected<Sampler*, Error> {
+        const auto sampler = new Sampler();
+        sampler->state = state;
+        countObject(&Statistics::samplers, true);
+
+        return sampler;
+    }
+
+    void NullRenderingDeviceDriver::destroySampler(
+        Sampler* sampler
+    ) {
+        delete sampler;
+        countObject(&Statistics::samplers, false);
+    }
+
+    Shader* NullRenderingDeviceDriver::createShaderFromSpirv(
+        const std::string& name,
+        const std::vector<ShaderStageData>& stages
+    ) {
+        const auto shader = new Shader();
+        shader->name = name;
+
+        if (const auto reflection = reflectShader(stages, shader); !reflection) {
+            const auto detail = reflection.error().detail;
+            delete shader;
+            error<CantCreateError>("Shader '" + name + "' reflection failed: " + detail);
+        }
+
+        countObject(&Statistics::shaders, true);
+
+        return shader;
+    }
+
+    void NullRenderingDeviceDriver::destroyShaderModules(
+        Shader*
+    ) {}
+
+    void NullRenderingDeviceDriver::destroyShader(
+        Shader* shader
+    ) {
+        delete shader;
+        countObject(&Statistics::shaders, false);
+    }
+
+    void NullRenderingDeviceDriver::commandBeginRenderPass(
+        CommandBuffer* commandBuffer,
+        const RenderingInfo& renderingInfo
+    ) {
+        const auto nullCommandBuffer = recordCommand(commandBuffer, "commandBeginRenderPass");
+        if (nullCommandBuffer->rendering)
+            nullCommandBuffer->errors.push_back("A render pass was begun inside another render pass.");
+        if (renderingInfo.extent.x == 0 || renderingInfo.extent.y == 0)
+            nullCommandBuffer->errors.push_back("A render pass was begun without an area to render to.");
+
+        nullCommandBuffer->rendering = true;
+        nullCommandBuffer->counts.renderPasses++;
+    }
+
+    void NullRenderingDeviceDriver::commandEndRenderPass(
+        CommandBuffer* commandBuffer
+    ) {
+        const auto nullCommandBuffer = recordCommand(commandBuffer, "commandEndRenderPass");
+        if (!nullCommandBuffer->rendering)
+            nullCommandBuffer->errors.push_back("A render pass was ended without being begun.");
+
+        nullCommandBuffer->rendering = false;
+    }
+
+    void NullRenderingDeviceDriver::commandExecuteCommandBuffers(
+        CommandBuffer* commandBuffer,
+        const std::span<CommandBuffer* const> commandBuffers
+    ) {
+        const auto nullCommandBuffer = recordCommand(commandBuffer, "commandExecuteCommandBuffers");
+        for (const auto secondary : commandBuffers) {
+            const auto nullSecondary = static_cast<NullCommandBuffer*>(secondary);
+            if (nullSecondary->recording)
+                nullCommandBuffer->errors.push_back("A command buffer was executed before it was ended.");
+
+            nullCommandBuffer->commands.emplace_back(nullSecondary);
+        }
+    }
+
+    void NullRenderingDeviceDriver::commandSetViewport(
+        CommandBuffer* commandBuffer,
+        const std::vector<glm::uvec2>&
+    ) {
+        recordCommand(commandBuffer, "commandSetViewport");
+    }
+
+    void NullRenderingDeviceDriver::commandSetScissor(
+        CommandBuffer* commandBuffer,
+        const std::vector<glm::uvec2>&
+    ) {
+        recordCommand(commandBuffer, "commandSetScissor");
+    }
+
+    void NullRenderingDeviceDriver::commandBindVertexBuffers(
+        CommandBuffer* commandBuffer,
+        uint32_t,
+        const std::vector<Buffer*>&,
+        const std::vector<uint64_t>&
+    ) {
+        recordCommand(commandBuffer, "commandBindVertexBuffers");
+    }
+
+    void NullRenderingDeviceDriver::commandBindIndexBuffers(
+        CommandBuffer* commandBuffer,
+        Buffer*,
+        IndexFormat,
+        uint64_t
+    ) {
+        recordCommand(commandBuffer, "commandBindIndexBuffers");
+    }
+
+    void NullRenderingDeviceDriver::commandPipelineBarrier(
+        CommandBuffer* commandBuffer,
+        PipelineStageFlags,
+        PipelineStageFlags,
+        const std::span<const MemoryBarrier> memoryBarriers,
+        const std::span<const BufferBarrier> bufferBarriers,
+        const std::span<const ImageBarrier> imageBarriers
+    ) {
+        const auto nullCommandBuffer = recordCommandOutsideRenderPass(commandBuffer, "commandPipelineBarrier");
+        nullCommandBuffer->counts.pipelineBarriers++;
+        countBarriers(nullCommandBuffer, memoryBarriers, bufferBarriers, imageBarriers);
+        nullCommandBuffer->commands.insert(
+            nullCommandBuffer->commands.end(),
+            imageBarriers.begin(),
+            imageBarriers.end()
+        );
+    }
+
+    void NullRenderingDeviceDriver::commandSetEvent(
+        CommandBuffer* commandBuffer,
+        Event* event,
+        PipelineStageFlags,
+        PipelineStageFlags,
+        const std::span<const MemoryBarrier> memoryBarriers,
+        const std::span<const BufferBarrier> bufferBarriers,
+        const std::span<const ImageBarrier> imageBarriers
+    ) {
+        const auto nullCommandBuffer = recordCommandOutsideRenderPass(commandBuffer, "commandSetEvent");
+        nullCommandBuffer->counts.eventCommands++;
+        countBarriers(nullCommandBuffer, memoryBarriers, bufferBarriers, imageBarriers);
+
+        // The barriers of an event are only applied by the wait, which must carry the same ones
+        nullCommandBuffer->commands.emplace_back(NullEventCommand{event, NullEventOperation::Set});
+    }
+
+    void NullRenderingDeviceDriver::commandWaitEvents(
+        CommandBuffer* commandBuffer,
+        const std::span<const EventWait> waits
+    ) {
+        const auto nullCommandBuffer = recordCommandOutsideRenderPass(commandBuffer, "commandWaitEvents");
+        nullCommandBuffer->counts.eventCommands++;
+        for (const auto& wait : waits) {
+            countBarriers(nullCommandBuffer, wait.memoryBarriers, wait.bufferBarriers, wait.imageBarriers);
+            nullCommandBuffer->commands.emplace_back(NullEventCommand{wait.event, NullEventOperation::Wait});
+            nullCommandBuffer->commands.insert(
+                nullCommandBuffer->commands.end(),
+                wait.imageBarriers.begin(),
+                wait.imageBarriers.end()
+            );
+        }
+    }
+
+    void NullRenderingDeviceDriver::commandResetEvent(
+        CommandBuffer* commandBuffer,
+        Event* event,
+        PipelineStageFlags
+    ) {
+        const auto nullCommandBuffer = recordCommandOutsideRenderPass(commandBuffer, "commandResetEvent");
+        nullCommandBuffer->counts.eventCommands++;
+        nullCommandBuffer->commands.emplace_back(NullEventCommand{event, NullEventOperation::Reset});
+    }
+
+    void NullRenderingDeviceDriver::commandResetQueryPool(
+        CommandBuffer* commandBuffer,
+        QueryPool*,
+        uint32_t,
+        uint32_t
+    ) {
+        recordCommandOutsideRenderPass(commandBuffer, "commandResetQueryPool");
+    }
+
+    void NullRenderingDeviceDriver::commandWriteTimestamp(
+        CommandBuffer* commandBuffer,
+        QueryPool*,
+        PipelineStageBits,
+        uint32_t
+    ) {
+        recordCommand(commandBuffer, "commandWriteTimestamp");
+    }
+
+    void NullRenderingDeviceDriver::commandClearBuffer(
+        CommandBuffer* commandBuffer,
+        Buffer*,
+        uint64_t,
+        uint64_t
+    ) {
+        recordTransfer(commandBuffer, "commandClearBuffer");
+    }
+
+    void NullRenderingDeviceDriver::commandCopyBuffer(
+        CommandBuffer* commandBuffer,
+        Buffer*,
+        Buffer*,
+        const std::vector<BufferCopyRegion>&
+    ) {
+        recordTransfer(commandBuffer, "commandCopyBuffer");
+    }
+
+    void NullRenderingDeviceDriver::commandCopyImage(
+        CommandBuffer* commandBuffer,
+        Image*,
+        ImageLayout,
+        Image*,
+        ImageLayout,
+        const std::vector<ImageCopyRegion>&
+    ) {
+        recordTransfer(commandBuffer, "commandCopyImage");
+    }
+
+    void NullRenderingDeviceDriver::commandResolveImage(
+        CommandBuffer* commandBuffer,
+        Image*,
+        ImageLayout,
+        uint32_t,
+        uint32_t,
+        Image*,
+        ImageLayout,
+        uint32_t,
+        uint32_t
+    ) {
+        recordTransfer(commandBuffer, "commandResolveImage");
+    }
+
+    void NullRenderingDeviceDriver::commandClearColorImage(
+        CommandBuffer* commandBuffer,
+        Image*,
+        ImageLayout,
+        const glm::vec4&,
+        const ImageSubresourceRange&
+    ) {
+        recordTransfer(commandBuffer, "commandClearColorImage");
+    }
+
+    void NullRenderingDeviceDriver::commandCopyBufferToImage(
+        CommandBuffer* commandBuffer,
+        Buffer*,
+        Image*,
+        ImageLayout,
+        const std::vector<BufferImageCopyRegion>&
+    ) {
+        recordTransfer(commandBuffer, "commandCopyBufferToImage");
+    }
+
+    void NullRenderingDeviceDriver::commandCopyImageToBuffer(
+        CommandBuffer* commandBuffer,
+        Image*,
+        ImageLayout,
+        Buffer*,
+        const std::vector<BufferImageCopyRegion>&
+    ) {
+        recordTransfer(commandBuffer, "commandCopyImageToBuffer");
+    }
+
+    void NullRenderingDeviceDriver::commandBeginLabel(
+        CommandBuffer* commandBuffer,
+        std::string_view,
+        const glm::vec3&
+    ) {
+        const auto nullCommandBuffer = recordCommand(commandBuffer, "commandBeginLabel");
+        nullCommandBuffer->openLabels++;
+        nullCommandBuffer->counts.labels++;
+    }
+
+    void NullRenderingDeviceDriver::commandEndLabel(
+        CommandBuffer* commandBuffer
+    ) {
+        const auto nullCommandBuffer = recordCommand(commandBuffer, "commandEndLabel");
+        if (nullCommandBuffer->openLabels == 0) {
+            nullCommandBuffer->errors.push_back("A label was ended without being begun.");
+            return;
+        }
+
+        nullCommandBuffer->openLabels--;
+    }
+}
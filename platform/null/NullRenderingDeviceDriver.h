@@ -0,0 +1,467 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "NullCommandBuffer.h"
+#include "core/RenderingDeviceDriver.h"
+
+namespace Vixen {
+    /**
+     * A rendering device driver without a GPU behind it. Objects are plain host allocations and recorded commands are
+     * only counted, so everything above the driver, such as the frame graph, can run and be measured on machines
+     * without a GPU. Submitted command buffers are checked for misuse the way a validation layer would, such as
+     * barriers whose old layout is not the layout the image is in, and the errors found are logged and kept.
+     */
+    class NullRenderingDeviceDriver final : public RenderingDeviceDriver {
+    public:
+        /**
+         * The objects alive on the device and the work submitted to it so far.
+         */
+        struct Statistics {
+            uint64_t images = 0;
+            uint64_t buffers = 0;
+            uint64_t memoryAllocations = 0;
+            uint64_t samplers = 0;
+            uint64_t shaders = 0;
+            uint64_t swapchains = 0;
+            uint64_t commandQueues = 0;
+            uint64_t commandPools = 0;
+            uint64_t fences = 0;
+            uint64_t semaphores = 0;
+            uint64_t events = 0;
+            uint64_t queryPools = 0;
+
+            uint64_t submissions = 0;
+            uint64_t presentations = 0;
+
+            /**
+             * The commands of every command buffer submitted so far.
+             */
+            NullCommandCounts commands{};
+
+            uint64_t validationErrors = 0;
+        };
+
+        /**
+         * The alignment memory requirements are reported with, matching what desktop GPUs commonly require of
+         * placed images.
+         */
+        static constexpr uint64_t MemoryAlignment = 64 * 1024;
+
+        /**
+         * The number of validation error messages kept, later errors are only counted.
+         */
+        static constexpr std::size_t MaxValidationErrors = 256;
+
+    private:
+        mutable std::mutex mutex;
+
+        Statistics statistics{};
+
+        std::vector<std::string> validationErrors;
+
+        /**
+         * Whether each event has been set by the command buffers submitted so far.
+         */
+        std::unordered_map<const Event*, bool> events;
+
+        static uint64_t getImageSize(
+            const ImageFormat& format
+        );
+
+        void countObject(
+            uint64_t Statistics::* objects,
+            bool created
+        );
+
+        void destroySwapchainFramebuffers(
+            Swapchain* swapchain
+        );
+
+        void addValidationError(
+            std::string message
+        );
+
+        void replayImageBarrier(
+            const NullCommandBuffer& commandBuffer,
+            const ImageBarrier& barrier
+        );
+
+        void replay(
+            const NullCommandBuffer& commandBuffer
+        );
+
+    public:
+        NullRenderingDeviceDriver() = default;
+
+        ~NullRenderingDeviceDriver() override;
+
+        [[nodiscard]] Statistics getStatistics() const;
+
+        [[nodiscard]] std::vector<std::string> getValidationErrors() const;
+
+        /**
+         * Forgets the validation errors found so far, along with their count.
+         */
+        void clearValidationErrors();
+
+        auto createSwapchain(
+            Surface* surface
+        ) -> std::expected<Swapchain*, Error> override;
+
+        auto resizeSwapchain(
+            CommandQueue* commandQueue,
+            Swapchain* swapchain,
+            uint32_t imageCount
+        ) -> std::expected<void, Error> override;
+
+        auto acquireSwapchainFramebuffer(
+            CommandQueue* commandQueue,
+            Swapchain* swapchain
+        ) -> std::expected<Framebuffer*, SwapchainError> override;
+
+        void destroySwapchain(
+            Swapchain* swapchain
+        ) override;
+
+        auto createFence() -> std::expected<Fence*, Error> override;
+
+        auto waitOnFence(
+            Fence* fence
+        ) -> std::expected<void, Error> override;
+
+        void destroyFence(
+            Fence* fence
+        ) override;
+
+        auto createSemaphore() -> std::expected<Semaphore*, Error> override;
+
+        auto waitOnSemaphore(
+            Semaphore* semaphore,
+            uint64_t value
+        ) -> std::expected<void, Error> override;
+
+        auto getSemaphoreValue(
+            Semaphore* semaphore
+        ) -> std::expected<uint64_t, Error> override;
+
+        void destroySemaphore(
+            Semaphore* semaphore
+        ) override;
+
+        auto createEvent() -> std::expected<Event*, Error> override;
+
+        void destroyEvent(
+            Event* event
+        ) override;
+
+        auto createQueryPool(
+            uint32_t count
+        ) -> std::expected<QueryPool*, Error> override;
+
+        auto getQueryPoolResults(
+            QueryPool* pool,
+            uint32_t first,
+            uint32_t count
+        ) -> std::expected<std::vector<std::optional<uint64_t>>, Error> override;
+
+        void destroyQueryPool(
+            QueryPool* pool
+        ) override;
+
+        auto createCommandPool(
+            uint32_t queueFamily,
+            CommandBufferType type
+        ) -> std::expected<CommandPool*, Error> override;
+
+        auto resetCommandPool(
+            CommandPool* pool
+        ) -> std::expected<void, Error> override;
+
+        void destroyCommandPool(
+            CommandPool* pool
+        ) override;
+
+        auto createCommandBuffer(
+            CommandPool* pool
+        ) -> std::expected<CommandBuffer*, Error> override;
+
+        auto beginCommandBuffer(
+            CommandBuffer* commandBuffer
+        ) -> std::expected<void, Error> override;
+
+        void endCommandBuffer(
+            CommandBuffer* commandBuffer
+        ) override;
+
+        auto createBuffer(
+            BufferUsageFlags usage,
+            uint32_t count,
+            uint32_t stride
+        ) -> std::expected<Buffer*, Error> override;
+
+        void destroyBuffer(
+            Buffer* buffer
+        ) override;
+
+        std::byte* mapBuffer(
+            Buffer* buffer
+        ) override;
+
+        void unmapBuffer(
+            Buffer* buffer
+        ) override;
+
+        auto getQueueFamily(
+            QueueFamilyFlags queueFamilyFlags,
+            Surface* surface
+        ) -> std::expected<uint32_t, Error> override;
+
+        auto createCommandQueue(
+            uint32_t queueFamilyIndex
+        ) -> std::expected<CommandQueue*, Error> override;
+
+        auto executeCommandQueueAndPresent(
+            CommandQueue* commandQueue,
+            const std::vector<Semaphore*>& waitSemaphores,
+            const std::vector<CommandBuffer*>& commandBuffers,
+            const std::vector<Semaphore*>& signalSemaphores,
+            Fence* fence,
+            const std::vector<Swapchain*>& swapchains
+        ) -> std::expected<void, Error> override;
+
+        void destroyCommandQueue(
+            CommandQueue* commandQueue
+        ) override;
+
+        auto createImage(
+            const ImageFormat& format,
+            const ImageView& view
+        ) -> std::expected<Image*, Error> override;
+
+        auto getBufferMemoryRequirements(
+            BufferUsageFlags usage,
+            uint32_t count,
+            uint32_t stride
+        ) -> std::expected<MemoryRequirements, Error> override;
+
+        auto getImageMemoryRequirements(
+            const ImageFormat& format
+        ) -> std::expected<MemoryRequirements, Error> override;
+
+        auto allocateMemory(
+            const MemoryRequirements& requirements
+        ) -> std::expected<MemoryAllocation*, Error> override;
+
+        void freeMemory(
+            MemoryAllocation* allocation
+        ) override;
+
+        auto createAliasedBuffer(
+            BufferUsageFlags usage,
+            uint32_t count,
+            uint32_t stride,
+            MemoryAllocation* allocation,
+            uint64_t offset
+        ) -> std::expected<Buffer*, Error> override;
+
+        auto createAliasedImage(
+            const ImageFormat& format,
+            const ImageView& view,
+            MemoryAllocation* allocation,
+            uint64_t offset
+        ) -> std::expected<Image*, Error> override;
+
+        std::byte* mapImage(
+            Image* image
+        ) override;
+
+        void unmapImage(
+            Image* image
+        ) override;
+
+        void destroyImage(
+            Image* image
+        ) override;
+
+        auto createSampler(
+            SamplerState state
+        ) -> std::expected<Sampler*, Error> override;
+
+        void destroySampler(
+            Sampler* sampler
+        ) override;
+
+        Shader* createShaderFromSpirv(
+            const std::string& name,
+            const std::vector<ShaderStageData>& stages
+        ) override;
+
+        void destroyShaderModules(
+            Shader* shader
+        ) override;
+
+        void destroyShader(
+            Shader* shader
+        ) override;
+
+        void commandBeginRenderPass(
+            CommandBuffer* commandBuffer,
+            const RenderingInfo& renderingInfo
+        ) override;
+
+        void commandEndRenderPass(
+            CommandBuffer* commandBuffer
+        ) override;
+
+        void commandExecuteCommandBuffers(
+            CommandBuffer* commandBuffer,
+            std::span<CommandBuffer* const> commandBuffers
+        ) override;
+
+        void commandSetViewport(
+            CommandBuffer* commandBuffer,
+            const std::vector<glm::uvec2>& viewports
+        ) override;
+
+        void commandSetScissor(
+            CommandBuffer* commandBuffer,
+            const std::vector<glm::uvec2>& scissors
+        ) override;
+
+        void commandBindVertexBuffers(
+            CommandBuffer* commandBuffer,
+            uint32_t count,
+            const std::vector<Buffer*>& buffers,
+            const std::vector<uint64_t>& offsets
+        ) override;
+
+        void commandBindIndexBuffers(
+            CommandBuffer* commandBuffer,
+            Buffer* buffer,
+            IndexFormat format,
+            uint64_t offset
+        ) override;
+
+        void commandPipelineBarrier(
+            CommandBuffer* commandBuffer,
+            PipelineStageFlags sourceStages,
+            PipelineStageFlags destinationStages,
+            std::span<const MemoryBarrier> memoryBarriers,
+            std::span<const BufferBarrier> bufferBarriers,
+            std::span<const ImageBarrier> imageBarriers
+        ) override;
+
+        void commandSetEvent(
+            CommandBuffer* commandBuffer,
+            Event* event,
+            PipelineStageFlags sourceStages,
+            PipelineStageFlags destinationStages,
+            std::span<const MemoryBarrier> memoryBarriers,
+            std::span<const BufferBarrier> bufferBarriers,
+            std::span<const ImageBarrier> imageBarriers
+        ) override;
+
+        void commandWaitEvents(
+            CommandBuffer* commandBuffer,
+            std::span<const EventWait> waits
+        ) override;
+
+        void commandResetEvent(
+            CommandBuffer* commandBuffer,
+            Event* event,
+            PipelineStageFlags stages
+        ) override;
+
+        void commandResetQueryPool(
+            CommandBuffer* commandBuffer,
+            QueryPool* pool,
+            uint32_t first,
+            uint32_t count
+        ) override;
+
+        void commandWriteTimestamp(
+            CommandBuffer* commandBuffer,
+            QueryPool* pool,
+            PipelineStageBits stage,
+            uint32_t query
+        ) override;
+
+        void commandClearBuffer(
+            CommandBuffer* commandBuffer,
+            Buffer* buffer,
+            uint64_t offset,
+            uint64_t size
+        ) override;
+
+        void commandCopyBuffer(
+            CommandBuffer* commandBuffer,
+            Buffer* source,
+            Buffer* destination,
+            const std::vector<BufferCopyRegion>& regions
+        ) override;
+
+        void commandCopyImage(
+            CommandBuffer* commandBuffer,
+            Image* source,
+            ImageLayout sourceLayout,
+            Image* destination,
+            ImageLayout destinationLayout,
+            const std::vector<ImageCopyRegion>& regions
+        ) override;
+
+        void commandResolveImage(
+            CommandBuffer* commandBuffer,
+            Image* source,
+            ImageLayout sourceLayout,
+            uint32_t sourceLayer,
+            uint32_t sourceMipmap,
+            Image* destination,
+            ImageLayout destinationLayout,
+            uint32_t destinationLayer,
+            uint32_t destinationMipmap
+        ) override;
+
+        void commandClearColorImage(
+            CommandBuffer* commandBuffer,
+            Image* image,
+            ImageLayout imageLayout,
+            const glm::vec4& color,
+            const ImageSubresourceRange& subresource
+        ) override;
+
+        void commandCopyBufferToImage(
+            CommandBuffer* commandBuffer,
+            Buffer* buffer,
+            Image* image,
+            ImageLayout layout,
+            const std::vector<BufferImageCopyRegion>& regions
+        ) override;
+
+        void commandCopyImageToBuffer(
+            CommandBuffer* commandBuffer,
+            Image* image,
+            ImageLayout layout,
+            Buffer* buffer,
+            const std::vector<BufferImageCopyRegion>& regions
+        ) override;
+
+        void commandBeginLabel(
+            CommandBuffer* commandBuffer,
+            std::string_view label,
+            const glm::vec3& color
+        ) override;
+
+        void commandEndLabel(
+            CommandBuffer* commandBuffer
+        ) override;
+    };
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+#include "core/command/Semaphore.h"
+
+namespace Vixen {
+    struct NullSemaphore final : Semaphore {
+        /**
+         * The value the semaphore was last signalled with, which it reaches as soon as it is submitted since the null
+         * device completes work immediately.
+         */
+        uint64_t value = 0;
+    };
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/Framebuffer.h"
+#include "core/Surface.h"
+#include "core/Swapchain.h"
+
+namespace Vixen {
+    struct NullSwapchain final : Swapchain {
+        Surface* surface = nullptr;
+
+        /**
+         * The framebuffers presented in turn, which are only created once the swapchain is first resized to its
+         * surface.
+         */
+        std::vector<Framebuffer*> framebuffers;
+
+        uint32_t imageIndex = 0;
+    };
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "core/MemoryAllocation.h"
+
+struct VmaAllocation_T;
+typedef VmaAllocation_T* VmaAllocation;
+
+namespace Vixen {
+    struct VulkanMemoryAllocation final : MemoryAllocation {
+        VmaAllocation allocation;
+    };
+}
@@ -337,7 +337,9 @@ namespace Vixen {
                 .type = deviceType,
                 .deviceLocalMemory = deviceLocalMemory,
                 .hasDedicatedComputeQueue = hasDedicatedComputeQueue,
-                .hasDedicatedTransferQueue = hasDedicatedTransferQueue
+                .hasDedicatedTransferQueue = hasDedicatedTransferQueue,
+                .uniformBufferOffsetAlignment = record.properties.limits.minUniformBufferOffsetAlignment,
+                .maxUniformBufferRange = record.properties.limits.maxUniformBufferRange
             };
 
             physicalDevices.push_back(std::move(record));
@@ -9,6 +9,7 @@
 #include "Vulkan.h"
 
 #include "AttachmentInfo.h"
+#include "VulkanMemoryAllocation.h"
 #include "VulkanRenderingContextDriver.h"
 #include "VulkanSwapchain.h"
 #include "buffer/BufferImageCopyRegion.h"
@@ -17,7 +18,9 @@
 #include "command/VulkanCommandBuffer.h"
 #include "command/VulkanCommandPool.h"
 #include "command/VulkanCommandQueue.h"
+#include "command/VulkanEvent.h"
 #include "command/VulkanFence.h"
+#include "command/VulkanQueryPool.h"
 #include "command/VulkanSemaphore.h"
 #include "core/error/CantCreateError.h"
 #include "core/error/Macros.h"
@@ -787,6 +790,42 @@ namespace Vixen {
         return std::unexpected(Error::InitializationFailed);
     }
 
+    auto VulkanRenderingDeviceDriver::releaseImageSemaphores(
+        VulkanSemaphore* semaphore,
+        const uint64_t value
+    ) -> std::expected<void, Error> {
+        const auto commandQueue = semaphore->queueSignaledFrom;
+        if (!commandQueue)
+            return {};
+
+        auto& imageSemaphores = commandQueue->imageSemaphoresForTimelines;
+        bool pending = false;
+        uint32_t i = 0;
+        while (i < imageSemaphores.size()) {
+            if (imageSemaphores[i].timeline != semaphore) {
+                i++;
+                continue;
+            }
+
+            if (imageSemaphores[i].value > value) {
+                pending = true;
+                i++;
+                continue;
+            }
+
+            if (!releaseImageSemaphore(commandQueue, imageSemaphores[i].imageSemaphore, true))
+                return std::unexpected(Error::InitializationFailed);
+
+            commandQueue->freeImageSemaphores.push_back(imageSemaphores[i].imageSemaphore);
+            imageSemaphores.erase(imageSemaphores.begin() + i);
+        }
+
+        if (!pending)
+            semaphore->queueSignaledFrom = nullptr;
+
+        return {};
+    }
+
     auto VulkanRenderingDeviceDriver::recreateImageSemaphore(
         VulkanCommandQueue* commandQueue,
         const uint32_t semaphoreIndex,
@@ -942,6 +981,41 @@ namespace Vixen {
         return semaphore;
     }
 
+    auto VulkanRenderingDeviceDriver::waitOnSemaphore(
+        Semaphore* semaphore,
+        const uint64_t value
+    ) -> std::expected<void, Error> {
+        const auto vkSemaphore = dynamic_cast<VulkanSemaphore*>(semaphore);
+
+        const VkSemaphoreWaitInfo waitInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .semaphoreCount = 1,
+            .pSemaphores = &vkSemaphore->semaphore,
+            .pValues = &value
+        };
+        if (vkWaitSemaphores(device, &waitInfo, std::numeric_limits<uint64_t>::max()) != VK_SUCCESS)
+            return std::unexpected(Error::InitializationFailed);
+
+        return releaseImageSemaphores(vkSemaphore, value);
+    }
+
+    auto VulkanRenderingDeviceDriver::getSemaphoreValue(
+        Semaphore* semaphore
+    ) -> std::expected<uint64_t, Error> {
+        const auto vkSemaphore = dynamic_cast<VulkanSemaphore*>(semaphore);
+
+        uint64_t value;
+        if (vkGetSemaphoreCounterValue(device, vkSemaphore->semaphore, &value) != VK_SUCCESS)
+            return std::unexpected(Error::InitializationFailed);
+
+        if (!releaseImageSemaphores(vkSemaphore, value))
+            return std::unexpected(Error::InitializationFailed);
+
+        return value;
+    }
+
     void VulkanRenderingDeviceDriver::destroySemaphore(
         Semaphore* semaphore
     ) {
@@ -950,6 +1024,88 @@ namespace Vixen {
         delete o;
     }
 
+    auto VulkanRenderingDeviceDriver::createEvent() -> std::expected<Event*, Error> {
+        constexpr VkEventCreateInfo eventInfo{
+            .sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = VK_EVENT_CREATE_DEVICE_ONLY_BIT
+        };
+
+        VkEvent o;
+        if (vkCreateEvent(device, &eventInfo, nullptr, &o) != VK_SUCCESS)
+            return std::unexpected(Error::InitializationFailed);
+
+        const auto event = new VulkanEvent();
+        event->event = o;
+        return event;
+    }
+
+    void VulkanRenderingDeviceDriver::destroyEvent(
+        Event* event
+    ) {
+        const auto o = dynamic_cast<VulkanEvent*>(event);
+        vkDestroyEvent(device, o->event, nullptr);
+        delete o;
+    }
+
+    auto VulkanRenderingDeviceDriver::createQueryPool(
+        const uint32_t count
+    ) -> std::expected<QueryPool*, Error> {
+        const VkQueryPoolCreateInfo queryPoolInfo{
+            .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .queryType = VK_QUERY_TYPE_TIMESTAMP,
+            .queryCount = count,
+            .pipelineStatistics = 0
+        };
+
+        VkQueryPool o;
+        if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &o) != VK_SUCCESS)
+            return std::unexpected(Error::InitializationFailed);
+
+        const auto pool = new VulkanQueryPool();
+        pool->queryPool = o;
+        return pool;
+    }
+
+    auto VulkanRenderingDeviceDriver::getQueryPoolResults(
+        QueryPool* pool,
+        const uint32_t first,
+        const uint32_t count
+    ) -> std::expected<std::vector<std::optional<uint64_t>>, Error> {
+        // Every query is read as its timestamp followed by whether it has been written.
+        std::vector<uint64_t> data(static_cast<std::size_t>(count) * 2);
+        const auto result = vkGetQueryPoolResults(
+            device,
+            dynamic_cast<VulkanQueryPool*>(pool)->queryPool,
+            first,
+            count,
+            data.size() * sizeof(uint64_t),
+            data.data(),
+            2 * sizeof(uint64_t),
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+        );
+        if (result != VK_SUCCESS && result != VK_NOT_READY)
+            return std::unexpected(Error::InitializationFailed);
+
+        const auto period = static_cast<double>(physicalDeviceProperties.limits.timestampPeriod);
+        std::vector<std::optional<uint64_t>> timestamps(count);
+        for (uint32_t i = 0; i < count; ++i)
+            if (data[i * 2 + 1] != 0)
+                timestamps[i] = static_cast<uint64_t>(static_cast<double>(data[i * 2]) * period);
+
+        return timestamps;
+    }
+
+    void VulkanRenderingDeviceDriver::destroyQueryPool(
+        QueryPool* pool
+    ) {
+        const auto o = dynamic_cast<VulkanQueryPool*>(pool);
+        vkDestroyQueryPool(device, o->queryPool, nullptr);
+        delete o;
+    }
+
     auto VulkanRenderingDeviceDriver::createCommandPool(
         const uint32_t queueFamily,
         const CommandBufferType type
@@ -1008,6 +1164,7 @@ namespace Vixen {
 
         const auto o = new VulkanCommandBuffer();
         o->commandBuffer = commandBuffer;
+        o->type = p->type;
 
         return o;
     }
@@ -1017,11 +1174,23 @@ namespace Vixen {
     ) -> std::expected<void, Error> {
         const auto o = dynamic_cast<VulkanCommandBuffer*>(commandBuffer);
 
-        constexpr VkCommandBufferBeginInfo beginInfo{
+        // Secondary command buffers begin and end their own rendering, so they inherit no render pass state
+        constexpr VkCommandBufferInheritanceInfo inheritanceInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+            .pNext = nullptr,
+            .renderPass = VK_NULL_HANDLE,
+            .subpass = 0,
+            .framebuffer = VK_NULL_HANDLE,
+            .occlusionQueryEnable = VK_FALSE,
+            .queryFlags = 0,
+            .pipelineStatistics = 0
+        };
+
+        const VkCommandBufferBeginInfo beginInfo{
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
             .pNext = nullptr,
             .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-            .pInheritanceInfo = nullptr
+            .pInheritanceInfo = o->type == CommandBufferType::Secondary ? &inheritanceInfo : nullptr
         };
         if (vkBeginCommandBuffer(o->commandBuffer, &beginInfo) != VK_SUCCESS)
             return std::unexpected(Error::InitializationFailed);
@@ -1167,6 +1336,18 @@ namespace Vixen {
                         vkCommandQueue->pendingSemaphoresForFence[i]
                     );
 
+                vkCommandQueue->pendingSemaphoresForFence.clear();
+            } else if (!signalSemaphores.empty() && !vkCommandQueue->pendingSemaphoresForFence.empty()) {
+                const auto timeline = dynamic_cast<VulkanSemaphore*>(signalSemaphores.back());
+                timeline->queueSignaledFrom = vkCommandQueue;
+
+                for (const auto semaphoreIndex : vkCommandQueue->pendingSemaphoresForFence)
+                    vkCommandQueue->imageSemaphoresForTimelines.push_back({
+                        .timeline = timeline,
+                        .value = timeline->value,
+                        .imageSemaphore = semaphoreIndex
+                    });
+
                 vkCommandQueue->pendingSemaphoresForFence.clear();
             }
 
@@ -1527,19 +1708,17 @@ namespace Vixen {
         delete vkCommandQueue;
     }
 
-    auto VulkanRenderingDeviceDriver::createBuffer(
+    VkBufferCreateInfo VulkanRenderingDeviceDriver::getBufferCreateInfo(
         const BufferUsageFlags usage,
         const uint32_t count,
         const uint32_t stride
-    ) -> std::expected<Buffer*, Error> {
+    ) {
         if (count <= 0)
             throw std::runtime_error("Count cannot be equal to or less than 0");
         if (stride <= 0)
             throw std::runtime_error("Stride cannot be equal to or less than 0");
 
-        VmaAllocationCreateFlags allocationFlags = 0;
         VkBufferUsageFlags bufferUsageFlags = 0;
-        VkMemoryPropertyFlags requiredFlags = 0;
 
         if (usage.contains(BufferUsageBits::Vertex))
             bufferUsageFlags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
@@ -1547,21 +1726,14 @@ namespace Vixen {
         if (usage.contains(BufferUsageBits::Index))
             bufferUsageFlags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
 
-        if (usage.contains(BufferUsageBits::CopySource)) {
-            allocationFlags |= VMA_ALLOCATION_CREATE_MAPPED_BIT |
-                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+        if (usage.contains(BufferUsageBits::CopySource))
             bufferUsageFlags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        }
 
         if (usage.contains(BufferUsageBits::CopyDestination))
             bufferUsageFlags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
-        if (usage.contains(BufferUsageBits::Uniform)) {
-            allocationFlags |= VMA_ALLOCATION_CREATE_MAPPED_BIT |
-                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+        if (usage.contains(BufferUsageBits::Uniform))
             bufferUsageFlags |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-            requiredFlags |= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-        }
 
         if (usage.contains(BufferUsageBits::Storage))
             bufferUsageFlags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
@@ -1572,7 +1744,7 @@ namespace Vixen {
         if (usage.contains(BufferUsageBits::Texel))
             bufferUsageFlags |= VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
 
-        const VkBufferCreateInfo bufferCreateInfo{
+        return {
             .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
             .pNext = nullptr,
             .flags = 0,
@@ -1582,52 +1754,11 @@ namespace Vixen {
             .queueFamilyIndexCount = 0,
             .pQueueFamilyIndices = nullptr
         };
-
-        const VmaAllocationCreateInfo allocationCreateInfo = {
-            .flags = allocationFlags,
-            .usage = VMA_MEMORY_USAGE_AUTO,
-            .requiredFlags = requiredFlags,
-            .preferredFlags = 0,
-            .memoryTypeBits = 0,
-            .pool = nullptr,
-            .pUserData = nullptr,
-            .priority = 0.0f
-        };
-
-        VkBuffer buffer;
-        VmaAllocation allocation;
-        VmaAllocationInfo allocationInfo;
-        if (vmaCreateBuffer(
-            allocator,
-            &bufferCreateInfo,
-            &allocationCreateInfo,
-            &buffer,
-            &allocation,
-            &allocationInfo
-        ) != VK_SUCCESS)
-            return std::unexpected(Error::InitializationFailed);
-
-        return new VulkanBuffer(
-            usage,
-            count,
-            stride,
-            buffer,
-            allocation
-        );
     }
 
-    void VulkanRenderingDeviceDriver::destroyBuffer(
-        Buffer* buffer
-    ) {
-        const auto o = dynamic_cast<VulkanBuffer*>(buffer);
-        vmaDestroyBuffer(allocator, o->buffer, o->allocation);
-        delete o;
-    }
-
-    auto VulkanRenderingDeviceDriver::createImage(
-        const ImageFormat& format,
-        const ImageView& view
-    ) -> std::expected<Image*, Error> {
+    VkImageCreateInfo VulkanRenderingDeviceDriver::getImageCreateInfo(
+        const ImageFormat& format
+    ) const {
         VkImageCreateInfo imageCreateInfo{
             .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
             .pNext = nullptr,
@@ -1677,6 +1808,128 @@ namespace Vixen {
         if (format.usage.contains(ImageUsageBits::CopyDestination))
             imageCreateInfo.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
+        return imageCreateInfo;
+    }
+
+    auto VulkanRenderingDeviceDriver::createImageView(
+        VkImage image,
+        const ImageFormat& format,
+        const ImageView& view
+    ) const -> std::expected<VkImageView, Error> {
+        const VkImageViewCreateInfo imageViewInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .image = image,
+            .viewType = toVkImageViewType(format.type),
+            .format = toVkDataFormat[format.format],
+            .components = {
+                .r = static_cast<VkComponentSwizzle>(view.swizzleRed),
+                .g = static_cast<VkComponentSwizzle>(view.swizzleGreen),
+                .b = static_cast<VkComponentSwizzle>(view.swizzleBlue),
+                .a = static_cast<VkComponentSwizzle>(view.swizzleAlpha)
+            },
+            .subresourceRange = {
+                .aspectMask = toVkImageAspectFlags(getImageAspects(format.format)),
+                .baseMipLevel = 0,
+                .levelCount = format.mipmapCount,
+                .baseArrayLayer = 0,
+                .layerCount = format.layerCount
+            }
+        };
+
+        VkImageView imageView;
+        if (vkCreateImageView(device, &imageViewInfo, nullptr, &imageView) != VK_SUCCESS)
+            return std::unexpected(Error::InitializationFailed);
+
+        return imageView;
+    }
+
+    auto VulkanRenderingDeviceDriver::createBuffer(
+        const BufferUsageFlags usage,
+        const uint32_t count,
+        const uint32_t stride
+    ) -> std::expected<Buffer*, Error> {
+        const VkBufferCreateInfo bufferCreateInfo = getBufferCreateInfo(usage, count, stride);
+
+        VmaAllocationCreateFlags allocationFlags = 0;
+        VkMemoryPropertyFlags requiredFlags = 0;
+
+        if (usage.contains(BufferUsageBits::CopySource)) {
+            allocationFlags |= VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+            requiredFlags |= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        }
+
+        if (usage.contains(BufferUsageBits::Uniform)) {
+            allocationFlags |= VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+            requiredFlags |= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        }
+
+        const VmaAllocationCreateInfo allocationCreateInfo = {
+            .flags = allocationFlags,
+            .usage = VMA_MEMORY_USAGE_AUTO,
+            .requiredFlags = requiredFlags,
+            .preferredFlags = 0,
+            .memoryTypeBits = 0,
+            .pool = nullptr,
+            .pUserData = nullptr,
+            .priority = 0.0f
+        };
+
+        VkBuffer buffer;
+        VmaAllocation allocation;
+        VmaAllocationInfo allocationInfo;
+        if (vmaCreateBuffer(
+            allocator,
+            &bufferCreateInfo,
+            &allocationCreateInfo,
+            &buffer,
+            &allocation,
+            &allocationInfo
+        ) != VK_SUCCESS)
+            return std::unexpected(Error::InitializationFailed);
+
+        return new VulkanBuffer(
+            usage,
+            count,
+            stride,
+            buffer,
+            allocation
+        );
+    }
+
+    void VulkanRenderingDeviceDriver::destroyBuffer(
+        Buffer* buffer
+    ) {
+        const auto o = dynamic_cast<VulkanBuffer*>(buffer);
+        vmaDestroyBuffer(allocator, o->buffer, o->allocation);
+        delete o;
+    }
+
+    std::byte* VulkanRenderingDeviceDriver::mapBuffer(
+        Buffer* buffer
+    ) {
+        const auto o = dynamic_cast<VulkanBuffer*>(buffer);
+        std::byte* data;
+        vmaMapMemory(allocator, o->allocation, std::bit_cast<void**>(&data));
+        return data;
+    }
+
+    void VulkanRenderingDeviceDriver::unmapBuffer(
+        Buffer* buffer
+    ) {
+        const auto o = dynamic_cast<VulkanBuffer*>(buffer);
+        vmaUnmapMemory(allocator, o->allocation);
+    }
+
+    auto VulkanRenderingDeviceDriver::createImage(
+        const ImageFormat& format,
+        const ImageView& view
+    ) -> std::expected<Image*, Error> {
+        VkImageCreateInfo imageCreateInfo = getImageCreateInfo(format);
+
         VmaAllocationCreateInfo allocationCreateInfo{
             .flags = static_cast<VmaAllocationCreateFlags>(
                 format.usage.contains(ImageUsageBits::CpuRead)
@@ -1729,41 +1982,178 @@ namespace Vixen {
         ) != VK_SUCCESS)
             return std::unexpected(Error::InitializationFailed);
 
-        VkImageView imageView;
-        const VkImageViewCreateInfo imageViewInfo{
-            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        const auto imageView = createImageView(image, format, view);
+        if (!imageView) {
+            vmaDestroyImage(allocator, image, allocation);
+            return std::unexpected(imageView.error());
+        }
+
+        const auto o = new VulkanImage();
+        o->format = format;
+        o->view = view;
+        o->image = image;
+        o->imageView = *imageView;
+        o->allocation = allocation;
+        return o;
+    }
+
+    auto VulkanRenderingDeviceDriver::getBufferMemoryRequirements(
+        const BufferUsageFlags usage,
+        const uint32_t count,
+        const uint32_t stride
+    ) -> std::expected<MemoryRequirements, Error> {
+        const VkBufferCreateInfo bufferCreateInfo = getBufferCreateInfo(usage, count, stride);
+
+        const VkDeviceBufferMemoryRequirements requirementsInfo{
+            .sType = VK_STRUCTURE_TYPE_DEVICE_BUFFER_MEMORY_REQUIREMENTS,
             .pNext = nullptr,
-            .flags = 0,
-            .image = image,
-            .viewType = toVkImageViewType(format.type),
-            .format = imageCreateInfo.format,
-            .components = {
-                .r = static_cast<VkComponentSwizzle>(view.swizzleRed),
-                .g = static_cast<VkComponentSwizzle>(view.swizzleGreen),
-                .b = static_cast<VkComponentSwizzle>(view.swizzleBlue),
-                .a = static_cast<VkComponentSwizzle>(view.swizzleAlpha)
-            },
-            .subresourceRange = {
-                .aspectMask = toVkImageAspectFlags(getImageAspects(format.format)),
-                .baseMipLevel = 0,
-                .levelCount = imageCreateInfo.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount = imageCreateInfo.arrayLayers
-            }
+            .pCreateInfo = &bufferCreateInfo
         };
 
-        if (const auto e = vkCreateImageView(device, &imageViewInfo, nullptr, &imageView);
-            e != VK_SUCCESS) {
-            vmaDestroyImage(allocator, image, allocation);
+        VkMemoryRequirements2 requirements{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+            .pNext = nullptr,
+            .memoryRequirements = {}
+        };
+        vkGetDeviceBufferMemoryRequirements(device, &requirementsInfo, &requirements);
+
+        return MemoryRequirements{
+            .size = requirements.memoryRequirements.size,
+            .alignment = requirements.memoryRequirements.alignment,
+            .memoryTypeBits = requirements.memoryRequirements.memoryTypeBits
+        };
+    }
+
+    auto VulkanRenderingDeviceDriver::getImageMemoryRequirements(
+        const ImageFormat& format
+    ) -> std::expected<MemoryRequirements, Error> {
+        const VkImageCreateInfo imageCreateInfo = getImageCreateInfo(format);
+
+        const VkDeviceImageMemoryRequirements requirementsInfo{
+            .sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS,
+            .pNext = nullptr,
+            .pCreateInfo = &imageCreateInfo,
+            .planeAspect = static_cast<VkImageAspectFlagBits>(0)
+        };
+
+        VkMemoryRequirements2 requirements{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+            .pNext = nullptr,
+            .memoryRequirements = {}
+        };
+        vkGetDeviceImageMemoryRequirements(device, &requirementsInfo, &requirements);
+
+        return MemoryRequirements{
+            .size = requirements.memoryRequirements.size,
+            .alignment = requirements.memoryRequirements.alignment,
+            .memoryTypeBits = requirements.memoryRequirements.memoryTypeBits
+        };
+    }
+
+    auto VulkanRenderingDeviceDriver::allocateMemory(
+        const MemoryRequirements& requirements
+    ) -> std::expected<MemoryAllocation*, Error> {
+        const VkMemoryRequirements memoryRequirements{
+            .size = requirements.size,
+            .alignment = requirements.alignment,
+            .memoryTypeBits = requirements.memoryTypeBits
+        };
+
+        const VmaAllocationCreateInfo allocationCreateInfo{
+            .flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT,
+            .usage = VMA_MEMORY_USAGE_UNKNOWN,
+            .requiredFlags = 0,
+            .preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            .memoryTypeBits = 0,
+            .pool = nullptr,
+            .pUserData = nullptr,
+            .priority = 0.0f
+        };
+
+        VmaAllocation allocation;
+        if (vmaAllocateMemory(
+            allocator,
+            &memoryRequirements,
+            &allocationCreateInfo,
+            &allocation,
+            nullptr
+        ) != VK_SUCCESS)
             return std::unexpected(Error::InitializationFailed);
+
+        const auto o = new VulkanMemoryAllocation();
+        o->size = requirements.size;
+        o->allocation = allocation;
+        return o;
+    }
+
+    void VulkanRenderingDeviceDriver::freeMemory(
+        MemoryAllocation* allocation
+    ) {
+        const auto o = dynamic_cast<VulkanMemoryAllocation*>(allocation);
+        vmaFreeMemory(allocator, o->allocation);
+        delete o;
+    }
+
+    auto VulkanRenderingDeviceDriver::createAliasedBuffer(
+        const BufferUsageFlags usage,
+        const uint32_t count,
+        const uint32_t stride,
+        MemoryAllocation* allocation,
+        const uint64_t offset
+    ) -> std::expected<Buffer*, Error> {
+        const auto memory = dynamic_cast<VulkanMemoryAllocation*>(allocation);
+        const VkBufferCreateInfo bufferCreateInfo = getBufferCreateInfo(usage, count, stride);
+
+        VkBuffer buffer;
+        if (vmaCreateAliasingBuffer2(
+            allocator,
+            memory->allocation,
+            offset,
+            &bufferCreateInfo,
+            &buffer
+        ) != VK_SUCCESS)
+            return std::unexpected(Error::InitializationFailed);
+
+        return new VulkanBuffer(
+            usage,
+            count,
+            stride,
+            buffer,
+            VK_NULL_HANDLE
+        );
+    }
+
+    auto VulkanRenderingDeviceDriver::createAliasedImage(
+        const ImageFormat& format,
+        const ImageView& view,
+        MemoryAllocation* allocation,
+        const uint64_t offset
+    ) -> std::expected<Image*, Error> {
+        const auto memory = dynamic_cast<VulkanMemoryAllocation*>(allocation);
+        const VkImageCreateInfo imageCreateInfo = getImageCreateInfo(format);
+
+        VkImage image;
+        if (vmaCreateAliasingImage2(
+            allocator,
+            memory->allocation,
+            offset,
+            &imageCreateInfo,
+            &image
+        ) != VK_SUCCESS)
+            return std::unexpected(Error::InitializationFailed);
+
+        const auto imageView = createImageView(image, format, view);
+        if (!imageView) {
+            vkDestroyImage(device, image, nullptr);
+            return std::unexpected(imageView.error());
         }
 
         const auto o = new VulkanImage();
         o->format = format;
         o->view = view;
         o->image = image;
-        o->imageView = imageView;
-        o->allocation = allocation;
+        o->imageView = *imageView;
+        o->allocation = VK_NULL_HANDLE;
         return o;
     }
 
@@ -2215,14 +2605,14 @@ namespace Vixen {
         CommandBuffer* commandBuffer,
         const RenderingInfo& renderingInfo
     ) {
-        const auto* vkCommandBuffer = dynamic_cast<VulkanCommandBuffer*>(commandBuffer);
+        auto* vkCommandBuffer = dynamic_cast<VulkanCommandBuffer*>(commandBuffer);
 
         DEBUG_ASSERT(vkCommandBuffer != nullptr);
         DEBUG_ASSERT(renderingInfo.extent.x > 0);
         DEBUG_ASSERT(renderingInfo.extent.y > 0);
 
-        std::vector<VkRenderingAttachmentInfo> colorAttachments;
-        colorAttachments.reserve(renderingInfo.colorAttachments.size());
+        auto& colorAttachments = vkCommandBuffer->colorAttachments;
+        colorAttachments.clear();
 
         for (const auto& attachment : renderingInfo.colorAttachments) {
             DEBUG_ASSERT(attachment.image != nullptr);
@@ -2336,6 +2726,24 @@ namespace Vixen {
         vkCmdEndRendering(dynamic_cast<VulkanCommandBuffer*>(commandBuffer)->commandBuffer);
     }
 
+    void VulkanRenderingDeviceDriver::commandExecuteCommandBuffers(
+        CommandBuffer* commandBuffer,
+        const std::span<CommandBuffer* const> commandBuffers
+    ) {
+        auto* vkCommandBuffer = dynamic_cast<VulkanCommandBuffer*>(commandBuffer);
+
+        auto& vkCommandBuffers = vkCommandBuffer->commandBuffers;
+        vkCommandBuffers.clear();
+        for (const auto& secondary : commandBuffers)
+            vkCommandBuffers.push_back(dynamic_cast<VulkanCommandBuffer*>(secondary)->commandBuffer);
+
+        vkCmdExecuteCommands(
+            vkCommandBuffer->commandBuffer,
+            vkCommandBuffers.size(),
+            vkCommandBuffers.data()
+        );
+    }
+
     void VulkanRenderingDeviceDriver::commandSetViewport(
         CommandBuffer* commandBuffer,
         const std::vector<glm::uvec2>& viewports
@@ -2424,16 +2832,39 @@ namespace Vixen {
         );
     }
 
-    void VulkanRenderingDeviceDriver::commandPipelineBarrier(
-        CommandBuffer* commandBuffer,
+    void VulkanRenderingDeviceDriver::reserveDependencies(
+        VulkanCommandBuffer& commandBuffer,
+        const std::size_t memoryBarrierCount,
+        const std::size_t bufferBarrierCount,
+        const std::size_t imageBarrierCount
+    ) {
+        commandBuffer.memoryBarriers.clear();
+        commandBuffer.memoryBarriers.reserve(memoryBarrierCount);
+        commandBuffer.bufferBarriers.clear();
+        commandBuffer.bufferBarriers.reserve(bufferBarrierCount);
+        commandBuffer.imageBarriers.clear();
+        commandBuffer.imageBarriers.reserve(imageBarrierCount);
+    }
+
+    VkDependencyInfo VulkanRenderingDeviceDriver::appendDependency(
+        VulkanCommandBuffer& commandBuffer,
         const PipelineStageFlags sourceStages,
         const PipelineStageFlags destinationStages,
-        const std::vector<MemoryBarrier>& memoryBarriers,
-        const std::vector<BufferBarrier>& bufferBarriers,
-        const std::vector<ImageBarrier>& imageBarriers
+        const std::span<const MemoryBarrier> memoryBarriers,
+        const std::span<const BufferBarrier> bufferBarriers,
+        const std::span<const ImageBarrier> imageBarriers
     ) {
-        std::vector<VkMemoryBarrier2> vkMemoryBarriers{};
-        vkMemoryBarriers.reserve(memoryBarriers.size());
+        auto& vkMemoryBarriers = commandBuffer.memoryBarriers;
+        auto& vkBufferBarriers = commandBuffer.bufferBarriers;
+        auto& vkImageBarriers = commandBuffer.imageBarriers;
+        DEBUG_ASSERT(vkMemoryBarriers.capacity() - vkMemoryBarriers.size() >= memoryBarriers.size());
+        DEBUG_ASSERT(vkBufferBarriers.capacity() - vkBufferBarriers.size() >= bufferBarriers.size());
+        DEBUG_ASSERT(vkImageBarriers.capacity() - vkImageBarriers.size() >= imageBarriers.size());
+
+        const std::size_t firstMemoryBarrier = vkMemoryBarriers.size();
+        const std::size_t firstBufferBarrier = vkBufferBarriers.size();
+        const std::size_t firstImageBarrier = vkImageBarriers.size();
+
         for (const auto& [sourceAccess, targetAccess] : memoryBarriers) {
             vkMemoryBarriers.push_back(
                 {
@@ -2447,9 +2878,15 @@ namespace Vixen {
             );
         }
 
-        std::vector<VkBufferMemoryBarrier2> vkBufferBarriers{};
-        vkBufferBarriers.reserve(bufferBarriers.size());
-        for (const auto& [buffer, sourceAccess, destinationAccess, offset, size] : bufferBarriers) {
+        for (const auto& [
+                 buffer,
+                 sourceAccess,
+                 destinationAccess,
+                 offset,
+                 size,
+                 sourceQueueFamily,
+                 destinationQueueFamily
+             ] : bufferBarriers) {
             vkBufferBarriers.push_back(
                 {
                     .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
@@ -2458,8 +2895,8 @@ namespace Vixen {
                     .srcAccessMask = toVkAccessFlags(sourceAccess),
                     .dstStageMask = toVkPipelineStages(destinationStages),
                     .dstAccessMask = toVkAccessFlags(destinationAccess),
-                    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                    .srcQueueFamilyIndex = sourceQueueFamily,
+                    .dstQueueFamilyIndex = destinationQueueFamily,
                     .buffer = dynamic_cast<VulkanBuffer*>(buffer)->buffer,
                     .offset = offset,
                     .size = size
@@ -2467,10 +2904,16 @@ namespace Vixen {
             );
         }
 
-        std::vector<VkImageMemoryBarrier2> vkImageBarriers{};
-        vkImageBarriers.reserve(imageBarriers.size());
-        for (const auto& [image, sourceAccess, destinationAccess, oldLayout, newLayout, subresources] :
-             imageBarriers) {
+        for (const auto& [
+                 image,
+                 sourceAccess,
+                 destinationAccess,
+                 oldLayout,
+                 newLayout,
+                 subresources,
+                 sourceQueueFamily,
+                 destinationQueueFamily
+             ] : imageBarriers) {
             vkImageBarriers.push_back(
                 {
                     .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
@@ -2481,8 +2924,8 @@ namespace Vixen {
                     .dstAccessMask = toVkAccessFlags(destinationAccess),
                     .oldLayout = toVkImageLayout(oldLayout),
                     .newLayout = toVkImageLayout(newLayout),
-                    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                    .srcQueueFamilyIndex = sourceQueueFamily,
+                    .dstQueueFamilyIndex = destinationQueueFamily,
                     .image = dynamic_cast<VulkanImage*>(image)->image,
                     .subresourceRange = {
                         .aspectMask = toVkImageAspectFlags(subresources.aspect),
@@ -2495,24 +2938,155 @@ namespace Vixen {
             );
         }
 
-        const VkDependencyInfo dependencyInfo{
+        return {
             .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
             .pNext = nullptr,
             .dependencyFlags = 0,
-            .memoryBarrierCount = static_cast<uint32_t>(vkMemoryBarriers.size()),
-            .pMemoryBarriers = vkMemoryBarriers.data(),
-            .bufferMemoryBarrierCount = static_cast<uint32_t>(vkBufferBarriers.size()),
-            .pBufferMemoryBarriers = vkBufferBarriers.data(),
-            .imageMemoryBarrierCount = static_cast<uint32_t>(vkImageBarriers.size()),
-            .pImageMemoryBarriers = vkImageBarriers.data()
+            .memoryBarrierCount = static_cast<uint32_t>(memoryBarriers.size()),
+            .pMemoryBarriers = vkMemoryBarriers.data() + firstMemoryBarrier,
+            .bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size()),
+            .pBufferMemoryBarriers = vkBufferBarriers.data() + firstBufferBarrier,
+            .imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size()),
+            .pImageMemoryBarriers = vkImageBarriers.data() + firstImageBarrier
         };
+    }
+
+    void VulkanRenderingDeviceDriver::commandPipelineBarrier(
+        CommandBuffer* commandBuffer,
+        const PipelineStageFlags sourceStages,
+        const PipelineStageFlags destinationStages,
+        const std::span<const MemoryBarrier> memoryBarriers,
+        const std::span<const BufferBarrier> bufferBarriers,
+        const std::span<const ImageBarrier> imageBarriers
+    ) {
+        auto* vkCommandBuffer = dynamic_cast<VulkanCommandBuffer*>(commandBuffer);
+
+        reserveDependencies(*vkCommandBuffer, memoryBarriers.size(), bufferBarriers.size(), imageBarriers.size());
+        const auto dependencyInfo = appendDependency(
+            *vkCommandBuffer,
+            sourceStages,
+            destinationStages,
+            memoryBarriers,
+            bufferBarriers,
+            imageBarriers
+        );
 
         vkCmdPipelineBarrier2(
-            dynamic_cast<VulkanCommandBuffer*>(commandBuffer)->commandBuffer,
+            vkCommandBuffer->commandBuffer,
+            &dependencyInfo
+        );
+    }
+
+    void VulkanRenderingDeviceDriver::commandSetEvent(
+        CommandBuffer* commandBuffer,
+        Event* event,
+        const PipelineStageFlags sourceStages,
+        const PipelineStageFlags destinationStages,
+        const std::span<const MemoryBarrier> memoryBarriers,
+        const std::span<const BufferBarrier> bufferBarriers,
+        const std::span<const ImageBarrier> imageBarriers
+    ) {
+        auto* vkCommandBuffer = dynamic_cast<VulkanCommandBuffer*>(commandBuffer);
+
+        reserveDependencies(*vkCommandBuffer, memoryBarriers.size(), bufferBarriers.size(), imageBarriers.size());
+        const auto dependencyInfo = appendDependency(
+            *vkCommandBuffer,
+            sourceStages,
+            destinationStages,
+            memoryBarriers,
+            bufferBarriers,
+            imageBarriers
+        );
+
+        vkCmdSetEvent2(
+            vkCommandBuffer->commandBuffer,
+            dynamic_cast<VulkanEvent*>(event)->event,
             &dependencyInfo
         );
     }
 
+    void VulkanRenderingDeviceDriver::commandWaitEvents(
+        CommandBuffer* commandBuffer,
+        const std::span<const EventWait> waits
+    ) {
+        auto* vkCommandBuffer = dynamic_cast<VulkanCommandBuffer*>(commandBuffer);
+
+        std::size_t memoryBarrierCount = 0;
+        std::size_t bufferBarrierCount = 0;
+        std::size_t imageBarrierCount = 0;
+        for (const auto& wait : waits) {
+            memoryBarrierCount += wait.memoryBarriers.size();
+            bufferBarrierCount += wait.bufferBarriers.size();
+            imageBarrierCount += wait.imageBarriers.size();
+        }
+        reserveDependencies(*vkCommandBuffer, memoryBarrierCount, bufferBarrierCount, imageBarrierCount);
+
+        auto& dependencyInfos = vkCommandBuffer->dependencyInfos;
+        auto& vkEvents = vkCommandBuffer->events;
+        dependencyInfos.clear();
+        vkEvents.clear();
+        for (const auto& wait : waits) {
+            dependencyInfos.push_back(
+                appendDependency(
+                    *vkCommandBuffer,
+                    wait.sourceStages,
+                    wait.destinationStages,
+                    wait.memoryBarriers,
+                    wait.bufferBarriers,
+                    wait.imageBarriers
+                )
+            );
+            vkEvents.push_back(dynamic_cast<VulkanEvent*>(wait.event)->event);
+        }
+
+        vkCmdWaitEvents2(
+            vkCommandBuffer->commandBuffer,
+            static_cast<uint32_t>(vkEvents.size()),
+            vkEvents.data(),
+            dependencyInfos.data()
+        );
+    }
+
+    void VulkanRenderingDeviceDriver::commandResetEvent(
+        CommandBuffer* commandBuffer,
+        Event* event,
+        const PipelineStageFlags stages
+    ) {
+        vkCmdResetEvent2(
+            dynamic_cast<VulkanCommandBuffer*>(commandBuffer)->commandBuffer,
+            dynamic_cast<VulkanEvent*>(event)->event,
+            toVkPipelineStages(stages)
+        );
+    }
+
+    void VulkanRenderingDeviceDriver::commandResetQueryPool(
+        CommandBuffer* commandBuffer,
+        QueryPool* pool,
+        const uint32_t first,
+        const uint32_t count
+    ) {
+        vkCmdResetQueryPool(
+            dynamic_cast<VulkanCommandBuffer*>(commandBuffer)->commandBuffer,
+            dynamic_cast<VulkanQueryPool*>(pool)->queryPool,
+            first,
+            count
+        );
+    }
+
+    void VulkanRenderingDeviceDriver::commandWriteTimestamp(
+        CommandBuffer* commandBuffer,
+        QueryPool* pool,
+        const PipelineStageBits stage,
+        const uint32_t query
+    ) {
+        vkCmdWriteTimestamp2(
+            dynamic_cast<VulkanCommandBuffer*>(commandBuffer)->commandBuffer,
+            toVkPipelineStages(stage),
+            dynamic_cast<VulkanQueryPool*>(pool)->queryPool,
+            query
+        );
+    }
+
     void VulkanRenderingDeviceDriver::commandClearBuffer(
         CommandBuffer* commandBuffer,
         Buffer* buffer,
@@ -2732,13 +3306,21 @@ namespace Vixen {
 
     void VulkanRenderingDeviceDriver::commandBeginLabel(
         CommandBuffer* commandBuffer,
-        const std::string& label,
+        const std::string_view label,
         const glm::vec3& color
     ) {
+        // Debug utils are only enabled in debug builds.
+        if (vkCmdBeginDebugUtilsLabelEXT == nullptr)
+            return;
+
+        // The label needs a terminator, long labels are cut short rather than copied to the heap
+        std::array<char, 256> labelName{};
+        label.copy(labelName.data(), labelName.size() - 1);
+
         const VkDebugUtilsLabelEXT info{
             .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT,
             .pNext = nullptr,
-            .pLabelName = label.c_str(),
+            .pLabelName = labelName.data(),
             .color = {
                 color.r,
                 color.g,
@@ -2755,6 +3337,9 @@ namespace Vixen {
     void VulkanRenderingDeviceDriver::commandEndLabel(
         CommandBuffer* commandBuffer
     ) {
+        if (vkCmdEndDebugUtilsLabelEXT == nullptr)
+            return;
+
         vkCmdEndDebugUtilsLabelEXT(dynamic_cast<VulkanCommandBuffer*>(commandBuffer)->commandBuffer);
     }
 }
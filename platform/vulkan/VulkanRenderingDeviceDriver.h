@@ -3,8 +3,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <optional>
 #include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <volk.h>
 
@@ -16,7 +19,9 @@ typedef struct VmaAllocator_T* VmaAllocator;
 
 namespace Vixen {
     struct ImageSubresourceLayers;
+    struct VulkanCommandBuffer;
     struct VulkanCommandQueue;
+    struct VulkanSemaphore;
     struct VulkanSwapchain;
     class VulkanRenderingContextDriver;
 
@@ -61,10 +66,50 @@ namespace Vixen {
             const ImageSamples& samples
         ) const;
 
+        static VkBufferCreateInfo getBufferCreateInfo(
+            BufferUsageFlags usage,
+            uint32_t count,
+            uint32_t stride
+        );
+
+        [[nodiscard]] VkImageCreateInfo getImageCreateInfo(
+            const ImageFormat& format
+        ) const;
+
+        auto createImageView(
+            VkImage image,
+            const ImageFormat& format,
+            const ImageView& view
+        ) const -> std::expected<VkImageView, Error>;
+
         void releaseSwapchain(
             VulkanSwapchain* swapchain
         );
 
+        /**
+         * Empties the barrier scratch storage of the command buffer without freeing it, and makes room for the given
+         * number of barriers so dependencies appended afterwards keep pointing at valid barriers.
+         */
+        static void reserveDependencies(
+            VulkanCommandBuffer& commandBuffer,
+            std::size_t memoryBarrierCount,
+            std::size_t bufferBarrierCount,
+            std::size_t imageBarrierCount
+        );
+
+        /**
+         * Translates the barriers into the scratch storage of the command buffer, after those already there, and
+         * returns a dependency pointing at them. reserveDependencies must have made room for them.
+         */
+        static VkDependencyInfo appendDependency(
+            VulkanCommandBuffer& commandBuffer,
+            PipelineStageFlags sourceStages,
+            PipelineStageFlags destinationStages,
+            std::span<const MemoryBarrier> memoryBarriers,
+            std::span<const BufferBarrier> bufferBarriers,
+            std::span<const ImageBarrier> imageBarriers
+        );
+
         static auto releaseImageSemaphore(
             VulkanCommandQueue* commandQueue,
             uint32_t semaphoreIndex,
@@ -77,6 +122,15 @@ namespace Vixen {
             bool releaseOnSwapchain
         ) const -> std::expected<void, Error>;
 
+        /**
+         * Frees the swapchain image semaphores waited on by the submissions that signalled the timeline semaphore up
+         * to the value, which the GPU has reached.
+         */
+        static auto releaseImageSemaphores(
+            VulkanSemaphore* semaphore,
+            uint64_t value
+        ) -> std::expected<void, Error>;
+
     public:
         VulkanRenderingDeviceDriver(
             VulkanRenderingContextDriver* renderingContext,
@@ -131,10 +185,39 @@ namespace Vixen {
 
         auto createSemaphore() -> std::expected<Semaphore*, Error> override;
 
+        auto waitOnSemaphore(
+            Semaphore* semaphore,
+            uint64_t value
+        ) -> std::expected<void, Error> override;
+
+        auto getSemaphoreValue(
+            Semaphore* semaphore
+        ) -> std::expected<uint64_t, Error> override;
+
         void destroySemaphore(
             Semaphore* semaphore
         ) override;
 
+        auto createEvent() -> std::expected<Event*, Error> override;
+
+        void destroyEvent(
+            Event* event
+        ) override;
+
+        auto createQueryPool(
+            uint32_t count
+        ) -> std::expected<QueryPool*, Error> override;
+
+        auto getQueryPoolResults(
+            QueryPool* pool,
+            uint32_t first,
+            uint32_t count
+        ) -> std::expected<std::vector<std::optional<uint64_t>>, Error> override;
+
+        void destroyQueryPool(
+            QueryPool* pool
+        ) override;
+
         auto createCommandPool(
             uint32_t queueFamily,
             CommandBufferType type
@@ -187,11 +270,52 @@ namespace Vixen {
             Buffer* buffer
         ) override;
 
+        std::byte* mapBuffer(
+            Buffer* buffer
+        ) override;
+
+        void unmapBuffer(
+            Buffer* buffer
+        ) override;
+
         auto createImage(
             const ImageFormat& format,
             const ImageView& view
         ) -> std::expected<Image*, Error> override;
 
+        auto getBufferMemoryRequirements(
+            BufferUsageFlags usage,
+            uint32_t count,
+            uint32_t stride
+        ) -> std::expected<MemoryRequirements, Error> override;
+
+        auto getImageMemoryRequirements(
+            const ImageFormat& format
+        ) -> std::expected<MemoryRequirements, Error> override;
+
+        auto allocateMemory(
+            const MemoryRequirements& requirements
+        ) -> std::expected<MemoryAllocation*, Error> override;
+
+        void freeMemory(
+            MemoryAllocation* allocation
+        ) override;
+
+        auto createAliasedBuffer(
+            BufferUsageFlags usage,
+            uint32_t count,
+            uint32_t stride,
+            MemoryAllocation* allocation,
+            uint64_t offset
+        ) -> std::expected<Buffer*, Error> override;
+
+        auto createAliasedImage(
+            const ImageFormat& format,
+            const ImageView& view,
+            MemoryAllocation* allocation,
+            uint64_t offset
+        ) -> std::expected<Image*, Error> override;
+
         std::byte* mapImage(
             Image* image
         ) override;
@@ -242,6 +366,11 @@ namespace Vixen {
             CommandBuffer* commandBuffer
         ) override;
 
+        void commandExecuteCommandBuffers(
+            CommandBuffer* commandBuffer,
+            std::span<CommandBuffer* const> commandBuffers
+        ) override;
+
         void commandSetViewport(
             CommandBuffer* commandBuffer,
             const std::vector<glm::uvec2>& viewports
@@ -270,9 +399,44 @@ namespace Vixen {
             CommandBuffer* commandBuffer,
             PipelineStageFlags sourceStages,
             PipelineStageFlags destinationStages,
-            const std::vector<MemoryBarrier>& memoryBarriers,
-            const std::vector<BufferBarrier>& bufferBarriers,
-            const std::vector<ImageBarrier>& imageBarriers
+            std::span<const MemoryBarrier> memoryBarriers,
+            std::span<const BufferBarrier> bufferBarriers,
+            std::span<const ImageBarrier> imageBarriers
+        ) override;
+
+        void commandSetEvent(
+            CommandBuffer* commandBuffer,
+            Event* event,
+            PipelineStageFlags sourceStages,
+            PipelineStageFlags destinationStages,
+            std::span<const MemoryBarrier> memoryBarriers,
+            std::span<const BufferBarrier> bufferBarriers,
+            std::span<const ImageBarrier> imageBarriers
+        ) override;
+
+        void commandWaitEvents(
+            CommandBuffer* commandBuffer,
+            std::span<const EventWait> waits
+        ) override;
+
+        void commandResetEvent(
+            CommandBuffer* commandBuffer,
+            Event* event,
+            PipelineStageFlags stages
+        ) override;
+
+        void commandResetQueryPool(
+            CommandBuffer* commandBuffer,
+            QueryPool* pool,
+            uint32_t first,
+            uint32_t count
+        ) override;
+
+        void commandWriteTimestamp(
+            CommandBuffer* commandBuffer,
+            QueryPool* pool,
+            PipelineStageBits stage,
+            uint32_t query
         ) override;
 
         void commandClearBuffer(
@@ -336,7 +500,7 @@ namespace Vixen {
 
         void commandBeginLabel(
             CommandBuffer* commandBuffer,
-            const std::string& label,
+            std::string_view label,
             const glm::vec3& color
         ) override;
 
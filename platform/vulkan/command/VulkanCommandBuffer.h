@@ -1,11 +1,35 @@
 #pragma once
 
+#include <vector>
+
 #include <volk.h>
 
 #include "core/command/CommandBuffer.h"
+#include "core/command/CommandBufferType.h"
 
 namespace Vixen {
     struct VulkanCommandBuffer final : CommandBuffer {
         VkCommandBuffer commandBuffer;
+
+        CommandBufferType type = CommandBufferType::Primary;
+
+        /**
+         * Scratch storage commands are translated into before they are recorded. It is cleared without being freed,
+         * so recording stops allocating once it has grown to fit the largest command. A command buffer is only
+         * recorded by one thread at a time, so it is never shared.
+         */
+        std::vector<VkMemoryBarrier2> memoryBarriers;
+
+        std::vector<VkBufferMemoryBarrier2> bufferBarriers;
+
+        std::vector<VkImageMemoryBarrier2> imageBarriers;
+
+        std::vector<VkDependencyInfo> dependencyInfos;
+
+        std::vector<VkEvent> events;
+
+        std::vector<VkCommandBuffer> commandBuffers;
+
+        std::vector<VkRenderingAttachmentInfo> colorAttachments;
     };
 }
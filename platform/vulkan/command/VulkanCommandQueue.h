@@ -10,6 +10,16 @@
 namespace Vixen {
     class Swapchain;
     class Fence;
+    struct VulkanSemaphore;
+
+    /**
+     * A swapchain image semaphore that is free again once the timeline semaphore has reached the value.
+     */
+    struct VulkanTimelineImageSemaphore {
+        VulkanSemaphore* timeline;
+        uint64_t value;
+        uint32_t imageSemaphore;
+    };
 
     struct VulkanCommandQueue final : CommandQueue {
         std::vector<VkSemaphore> imageSemaphores{};
@@ -18,6 +28,7 @@ namespace Vixen {
         std::vector<uint32_t> pendingSemaphoresForFence{};
         std::vector<uint32_t> freeImageSemaphores{};
         std::vector<std::pair<Fence*, uint32_t>> imageSemaphoresForFences{};
+        std::vector<VulkanTimelineImageSemaphore> imageSemaphoresForTimelines{};
         uint32_t queueFamily = 0;
         uint32_t queueIndex = 0;
     };
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <volk.h>
+
+#include "core/command/Event.h"
+
+namespace Vixen {
+    struct VulkanEvent final : Event {
+        VkEvent event;
+    };
+}
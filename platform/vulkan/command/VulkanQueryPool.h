@@ -0,0 +1,11 @@
+#pragma once
+
+#include <volk.h>
+
+#include "core/command/QueryPool.h"
+
+namespace Vixen {
+    struct VulkanQueryPool final : QueryPool {
+        VkQueryPool queryPool;
+    };
+}
@@ -6,8 +6,11 @@
 #include "core/command/Semaphore.h"
 
 namespace Vixen {
+    struct VulkanCommandQueue;
+
     struct VulkanSemaphore : Semaphore {
         VkSemaphore semaphore;
         uint64_t value;
+        VulkanCommandQueue* queueSignaledFrom;
     };
 }